@@ -0,0 +1,43 @@
+import glob, os, subprocess, sys, argparse
+
+def main(args):
+    benchpath = os.path.dirname(os.path.abspath(__file__))
+    buildpath = os.path.join(benchpath, '__build__')
+
+    # Configure and compile all configurations
+    print('Configure the CMake', file=sys.stderr, flush=True)
+    subprocess.run(['cmake', '-S', benchpath, '-B', buildpath, '-DCMAKE_BUILD_TYPE=Release'], check=True, stdout=sys.stderr)
+    print('Compile', file=sys.stderr, flush=True)
+    subprocess.run(['cmake', '--build', buildpath], check=True, stdout=sys.stderr)
+
+    # Run each configuration, results are merged to single CSV with one header
+    out = open(args.output, 'w') if args.output else sys.stdout
+    header = False
+    for exe in sorted(glob.glob(os.path.join(buildpath, 'lwbtn_bench_*'))):
+        if args.config and os.path.basename(exe) not in ['lwbtn_bench_' + c for c in args.config]:
+            continue
+        print('Run', os.path.basename(exe), file=sys.stderr, flush=True)
+        res = subprocess.run([exe, str(args.max_buttons), str(args.budget)], check=True, capture_output=True, text=True)
+        lines = res.stdout.splitlines()
+        if header:
+            lines = lines[1:]
+        header = True
+        out.write('\n'.join(lines) + '\n')
+        out.flush()
+    if args.output:
+        out.close()
+    return 0
+
+# Get parser
+def get_parser():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--output", required=False, help="Output CSV file, standard output if not set")
+    parser.add_argument("--config", required=False, action='append', help="Run only this configuration, can be repeated")
+    parser.add_argument("--max-buttons", required=False, type=int, default=100000, help="Largest number of buttons")
+    parser.add_argument("--budget", required=False, type=int, default=10000000, help="Button ticks per run")
+    return parser
+
+# Run the script
+if __name__ == '__main__':
+    parser = get_parser()
+    sys.exit(main(parser.parse_args()))
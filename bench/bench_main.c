@@ -0,0 +1,170 @@
+/**
+ * \file            bench_main.c
+ * \brief           Processing benchmark for single library configuration
+ *
+ * Runs idle, bouncing, pressed and click workloads for groups of 1 to 100000 buttons,
+ * and prints one CSV line per run to standard output.
+ *
+ * Usage: lwbtn_bench_<config> [max_buttons] [budget]
+ *
+ * - max_buttons: Largest number of buttons in the sweep, default `100000`
+ * - budget: Number of processed button ticks per run, default `10000000`.
+ *          Every run processes at least `LWBTN_BENCH_TICKS_MIN` ticks
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwbtn/lwbtn.h"
+
+#ifndef LWBTN_BENCH_CONFIG
+#define LWBTN_BENCH_CONFIG "unknown"
+#endif
+
+/* Buttons in one group. Group count is 16-bit, larger sweeps use several groups */
+#define LWBTN_BENCH_GROUP_BTNS 50000U
+/* Minimum ticks per run, to pass several workload periods */
+#define LWBTN_BENCH_TICKS_MIN  400U
+
+/**
+ * \brief           Input workload
+ */
+typedef enum {
+    BENCH_WORKLOAD_IDLE = 0x00, /*!< All buttons released */
+    BENCH_WORKLOAD_BOUNCING,    /*!< Presses of 100 ms every 200 ms, with 10 ms of contact bounce on both edges */
+    BENCH_WORKLOAD_PRESSED,     /*!< All buttons pressed, keep alive events */
+    BENCH_WORKLOAD_CLICK,       /*!< Presses of 50 ms every 150 ms, multi-click sequences */
+    BENCH_WORKLOAD_END,
+} bench_workload_t;
+
+static const char* workload_names[] = {"idle", "bouncing", "pressed", "click"};
+static const uint32_t btns_counts[] = {1, 10, 100, 1000, 10000, 100000};
+
+static lwbtn_btn_t* btns;
+static lwbtn_t* groups;
+static size_t groups_cnt;
+static bench_workload_t workload;
+static uint32_t tick;
+static unsigned long evts;
+
+/**
+ * \brief           Get input state of the button at specific tick
+ * \param[in]       idx: Button index in the sweep
+ * \param[in]       time: Tick in milliseconds
+ * \return          `1` when active, `0` otherwise
+ */
+static uint8_t
+prv_input(uint32_t idx, uint32_t time) {
+    uint32_t t;
+
+    switch (workload) {
+        case BENCH_WORKLOAD_BOUNCING:
+            t = (time + idx * 13U) % 200U;
+            if (t < 10U || (t >= 100U && t < 110U)) {
+                return (uint8_t)(t & 1U);
+            }
+            return t < 100U;
+        case BENCH_WORKLOAD_PRESSED: return time > 0;
+        case BENCH_WORKLOAD_CLICK: return ((time + idx * 13U) % 150U) < 50U;
+        default: return 0;
+    }
+}
+
+#if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    return prv_input((uint32_t)(btn - btns), tick);
+}
+#endif /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL */
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    (void)lwobj;
+    (void)btn;
+    (void)evt;
+    ++evts;
+}
+
+/* Get monotonic time in nanoseconds */
+static double
+prv_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * \brief           Run one workload for specific number of buttons and print the result
+ * \param[in]       btns_cnt: Number of buttons
+ * \param[in]       ticks: Number of processed ticks
+ */
+static void
+prv_run(uint32_t btns_cnt, uint32_t ticks) {
+    double start, ns;
+
+    /* Fresh groups, buttons are split evenly */
+    memset(btns, 0x00, btns_cnt * sizeof(*btns));
+    groups_cnt = (btns_cnt + LWBTN_BENCH_GROUP_BTNS - 1U) / LWBTN_BENCH_GROUP_BTNS;
+    for (size_t i = 0, off = 0; i < groups_cnt; ++i) {
+        uint16_t cnt = (uint16_t)((btns_cnt - off) / (groups_cnt - i));
+
+#if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL
+        lwbtn_init_ex(&groups[i], &btns[off], cnt, NULL, prv_event);
+#else
+        lwbtn_init_ex(&groups[i], &btns[off], cnt, prv_get_state, prv_event);
+#endif /* LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL */
+        off += cnt;
+    }
+    evts = 0;
+
+    start = prv_time_ns();
+    for (tick = 0; tick < ticks; ++tick) {
+#if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL
+        /* Application sets states of all buttons before processing */
+        for (uint32_t i = 0; i < btns_cnt; ++i) {
+            lwbtn_set_btn_state(&btns[i], prv_input(i, tick));
+        }
+#endif /* LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL */
+        for (size_t i = 0; i < groups_cnt; ++i) {
+            lwbtn_process_ex(&groups[i], (lwbtn_time_t)tick);
+        }
+    }
+    ns = prv_time_ns() - start;
+
+    printf("%s,%s,%lu,%lu,%u,%.3f,%.0f,%lu\n", LWBTN_BENCH_CONFIG, workload_names[workload], (unsigned long)btns_cnt,
+           (unsigned long)ticks, (unsigned)sizeof(lwbtn_btn_t), ns / ((double)btns_cnt * (double)ticks),
+           ns > 0 ? (double)evts * 1e9 / ns : 0.0, evts);
+    fflush(stdout);
+}
+
+int
+main(int argc, char* argv[]) {
+    unsigned long max_btns = argc > 1 ? strtoul(argv[1], NULL, 0) : 100000UL;
+    unsigned long budget = argc > 2 ? strtoul(argv[2], NULL, 0) : 10000000UL;
+
+    btns = calloc(max_btns > 0 ? max_btns : 1, sizeof(*btns));
+    groups = calloc(max_btns / LWBTN_BENCH_GROUP_BTNS + 1, sizeof(*groups));
+    if (btns == NULL || groups == NULL) {
+        printf("Cannot allocate memory for %lu buttons\r\n", max_btns);
+        return -1;
+    }
+
+    printf("config,workload,buttons,ticks,btn_size,ns_per_btn_tick,events_per_sec,events\n");
+    for (size_t c = 0; c < sizeof(btns_counts) / sizeof(btns_counts[0]) && btns_counts[c] <= max_btns; ++c) {
+        uint32_t ticks = (uint32_t)(budget / btns_counts[c]);
+
+        if (ticks < LWBTN_BENCH_TICKS_MIN) {
+            ticks = LWBTN_BENCH_TICKS_MIN;
+        }
+        for (workload = BENCH_WORKLOAD_IDLE; workload < BENCH_WORKLOAD_END; ++workload) {
+            prv_run(btns_counts[c], ticks);
+        }
+    }
+
+    free(groups);
+    free(btns);
+    return 0;
+}
@@ -41,4 +41,7 @@
  * copy & replace here settings you want to change values
  */
 
+/* Process buttons only on input edge and on timer expiry, sleep otherwise */
+#define LWBTN_CFG_USE_TIMER 1
+
 #endif /* LWBTN_HDR_OPTS_H */
@@ -6,9 +6,13 @@ static void MX_GPIO_Init(void);
 
 static uint8_t prv_btn_get_state(struct lwbtn* lw, struct lwbtn_btn* btn);
 static void prv_btn_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt);
+static void prv_btn_set_timer(struct lwbtn* lw, lwbtn_deadline_t status, lwbtn_time_t time);
 
 /* Local variables */
 static lwbtn_btn_t btns[1];
+static volatile uint8_t btn_edge;
+static uint8_t timer_armed;
+static uint32_t timer_time;
 
 /**
   * @brief  The application entry point.
@@ -27,10 +31,18 @@ main(void) {
 
     /* Define buttons */
     lwbtn_init_ex(NULL, btns, sizeof(btns) / sizeof(btns[0]), prv_btn_get_state, prv_btn_event);
+    lwbtn_timer_init(NULL, prv_btn_set_timer);
+    lwbtn_process_ex(NULL, HAL_GetTick());
 
     while (1) {
-        /* Periodic processing function */
-        lwbtn_process_ex(NULL, HAL_GetTick());
+        /* Process only on input edge or when requested time has been reached */
+        if (btn_edge || (timer_armed && (int32_t)(HAL_GetTick() - timer_time) >= 0)) {
+            btn_edge = 0;
+            lwbtn_process_ex(NULL, HAL_GetTick());
+        }
+
+        /* Sleep until next interrupt, edge or system tick */
+        __WFI();
     }
 }
 
@@ -40,6 +52,21 @@ prv_btn_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
     return HAL_GPIO_ReadPin(BTN_GPIO_Port, BTN_Pin) == GPIO_PIN_SET;
 }
 
+/* Arm or stop the timer, as requested by the library */
+static void
+prv_btn_set_timer(struct lwbtn* lw, lwbtn_deadline_t status, lwbtn_time_t time) {
+    timer_armed = status == LWBTN_DEADLINE_PENDING;
+    timer_time = time;
+}
+
+/* Input edge interrupt */
+void
+HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+    if (GPIO_Pin == BTN_Pin) {
+        btn_edge = 1;
+    }
+}
+
 /* Process button event */
 static void
 prv_btn_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
@@ -108,13 +135,11 @@ MX_GPIO_Init(void) {
     /*Configure GPIO pin Output Level */
     HAL_GPIO_WritePin(OUT_GPIO_Port, OUT_Pin, GPIO_PIN_RESET);
     HAL_GPIO_WritePin(OUT_CLICK_GPIO_Port, OUT_CLICK_Pin, GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(BTN_GPIO_Port, BTN_Pin, GPIO_PIN_RESET);
 
     /* Configure GPIO pin : BTN_Pin */
     GPIO_InitStruct.Pin = BTN_Pin;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
     GPIO_InitStruct.Pull = GPIO_NOPULL;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
     HAL_GPIO_Init(BTN_GPIO_Port, &GPIO_InitStruct);
 
     /*Configure GPIO pin : OUT_Pin */
@@ -131,6 +156,10 @@ MX_GPIO_Init(void) {
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
     HAL_GPIO_Init(OUT_CLICK_GPIO_Port, &GPIO_InitStruct);
 
+    /* EXTI interrupt init */
+    HAL_NVIC_SetPriority(EXTI4_15_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(EXTI4_15_IRQn);
+
     /* USER CODE BEGIN MX_GPIO_Init_2 */
     /* USER CODE END MX_GPIO_Init_2 */
 }
@@ -17,6 +17,41 @@ static lwbtn_btn_t btns[] = {
     {.arg = (void*)&keys[8]}, {.arg = (void*)&keys[9]},
 };
 
+#if LWBTN_CFG_USE_TIMER
+/* Emulated one-shot timer, armed by the library */
+static uint8_t timer_armed;
+static uint32_t timer_time;
+
+/**
+ * \brief           Set timer callback
+ * \param           lw: LwBTN instance
+ * \param           status: Timer status
+ * \param           time: Time to process the group at
+ */
+void
+prv_btn_set_timer(struct lwbtn* lw, lwbtn_deadline_t status, lwbtn_time_t time) {
+    (void)lw;
+    timer_armed = status == LWBTN_DEADLINE_PENDING;
+    timer_time = time;
+}
+
+/**
+ * \brief           Get bit mask of pressed keys, used to emulate input edge interrupt
+ * \return          Mask of pressed keys
+ */
+static uint32_t
+prv_get_keys_mask(void) {
+    uint32_t mask = 0;
+
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        if (GetAsyncKeyState(keys[i]) < 0) {
+            mask |= 1UL << i;
+        }
+    }
+    return mask;
+}
+#endif /* LWBTN_CFG_USE_TIMER */
+
 /**
  * \brief           Get input state callback 
  * \param           lw: LwBTN instance
@@ -109,17 +144,33 @@ prv_btn_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
 int
 example_win32(void) {
     uint32_t time_last;
+#if LWBTN_CFG_USE_TIMER
+    uint32_t keys_mask, keys_mask_last = 0;
+#endif /* LWBTN_CFG_USE_TIMER */
     printf("Application running\r\n");
     QueryPerformanceFrequency(&freq);
     QueryPerformanceCounter(&sys_start_time);
 
     /* Define buttons */
     lwbtn_init_ex(NULL, btns, sizeof(btns) / sizeof(btns[0]), prv_btn_get_state, prv_btn_event);
+#if LWBTN_CFG_USE_TIMER
+    lwbtn_timer_init(NULL, prv_btn_set_timer);
+    lwbtn_process_ex(NULL, get_tick());
+#endif /* LWBTN_CFG_USE_TIMER */
 
     time_last = get_tick();
     while (1) {
+#if LWBTN_CFG_USE_TIMER
+        /* Process only on key change (input edge) or when armed timer expires */
+        keys_mask = prv_get_keys_mask();
+        if (keys_mask != keys_mask_last || (timer_armed && (int32_t)(get_tick() - timer_time) >= 0)) {
+            keys_mask_last = keys_mask;
+            lwbtn_process_ex(NULL, get_tick());
+        }
+#else  /* LWBTN_CFG_USE_TIMER */
         /* Process forever */
         lwbtn_process_ex(NULL, get_tick());
+#endif /* !LWBTN_CFG_USE_TIMER */
 
         /* Manually read button state */
 #if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL
@@ -38,6 +38,10 @@
 #include <string.h>
 #include "lwbtn/lwbtn_opt.h"
 
+#if LWBTN_CFG_USE_PARALLEL
+#include <pthread.h>
+#endif /* LWBTN_CFG_USE_PARALLEL */
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -66,12 +70,50 @@ typedef struct {
 /* Forward declarations */
 struct lwbtn_btn;
 struct lwbtn;
+struct lwbtn_par;
 
 /**
  * \brief           Time variable type
  */
 typedef LWBTN_CFG_TIME_VARTYPE lwbtn_time_t;
 
+/**
+ * \brief           Time variable type, stored in the button structure
+ */
+#if LWBTN_CFG_USE_COMPACT
+typedef uint16_t lwbtn_btn_time_t;
+#else
+typedef lwbtn_time_t lwbtn_btn_time_t;
+#endif /* LWBTN_CFG_USE_COMPACT */
+
+/**
+ * \brief           Word type for button bit masks. Each bit represents one button
+ */
+typedef LWBTN_CFG_WORD_TYPE lwbtn_word_t;
+
+/**
+ * \brief           Number of bits (buttons) in one \ref lwbtn_word_t word
+ */
+#define LWBTN_WORD_BITS                  (sizeof(lwbtn_word_t) * 8U)
+
+/**
+ * \brief           Get number of \ref lwbtn_word_t words required for bit mask of specific number of buttons
+ * \param[in]       btns_cnt: Number of buttons
+ * \return          Number of words
+ */
+#define LWBTN_BITMAP_WORDS(btns_cnt)     (((btns_cnt) + LWBTN_WORD_BITS - 1U) / LWBTN_WORD_BITS)
+
+/**
+ * \brief           Get number of \ref lwbtn_word_t words required for group state mask memory
+ * 
+ * Memory holds current and previously processed input states of the group
+ * 
+ * \param[in]       btns_cnt: Number of buttons
+ * \return          Number of words
+ * \sa              lwbtn_state_mask_init
+ */
+#define LWBTN_STATE_MASK_WORDS(btns_cnt) (2U * LWBTN_BITMAP_WORDS(btns_cnt))
+
 /**
  * \brief           List of button events
  * 
@@ -87,6 +129,180 @@ typedef enum {
 #endif                   /* LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__ */
 } lwbtn_evt_t;
 
+#if LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__
+
+/**
+ * \brief           Number of event types, size of event functions table
+ */
+#define LWBTN_EVT_CNT       (2U + !!LWBTN_CFG_USE_CLICK + !!LWBTN_CFG_USE_KEEPALIVE)
+
+/**
+ * \brief           Subscription mask of single event
+ * \param[in]       evt: Event type, member of \ref lwbtn_evt_t
+ */
+#define LWBTN_EVT_MASK(evt) ((uint8_t)(1U << (evt)))
+
+/**
+ * \brief           Subscription mask of all events
+ */
+#define LWBTN_EVT_MASK_ALL  ((uint8_t)((1U << LWBTN_EVT_CNT) - 1U))
+
+#endif /* LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__ */
+
+/**
+ * \brief           Result of next deadline query
+ * \sa              lwbtn_get_next_deadline
+ */
+typedef enum {
+    LWBTN_DEADLINE_IDLE = 0x00, /*!< No pending timeouts. Processing can only change state on next input edge */
+    LWBTN_DEADLINE_PENDING,     /*!< At least one timeout is pending, deadline time is valid */
+} lwbtn_deadline_t;
+
+#if LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Event queue overflow policy
+ * \sa              lwbtn_evt_queue_init
+ */
+typedef enum {
+    LWBTN_EVT_QUEUE_DROP_NEWEST = 0x00, /*!< New event is dropped when queue is full */
+    LWBTN_EVT_QUEUE_DROP_OLDEST,        /*!< Oldest unread event is overwritten when queue is full.
+                                            Queue holds up to `size - 1` newest events */
+    LWBTN_EVT_QUEUE_COALESCE_KEEPALIVE, /*!< Keep alive event is dropped when less than quarter of queue is free,
+                                            keeping space for other events. Next stored keep alive event
+                                            carries actual keep alive counter */
+} lwbtn_evt_queue_policy_t;
+
+#endif /* LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_QUEUE || LWBTN_CFG_USE_EVT_BATCH || LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__
+
+/**
+ * \brief           Event record, stored to event queue or event batch, or sent to event info function
+ */
+typedef struct {
+    lwbtn_time_t time;      /*!< Time of processing call that generated the event */
+    uint16_t btn_idx;       /*!< Button index in the group */
+    uint16_t keepalive_cnt; /*!< Keep alive counter at the time of event */
+    uint8_t evt;            /*!< Event type, member of \ref lwbtn_evt_t */
+    uint8_t click_cnt;      /*!< Click counter at the time of event */
+#if LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__
+    lwbtn_time_t time_pressed;   /*!< Time since on-press, for keep alive and on-release events. `0` for other events */
+    lwbtn_time_t time_click_gap; /*!< Time since last click of current sequence, `0` when there is none */
+#endif                           /* LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__ */
+} lwbtn_evt_rec_t;
+
+#endif /* LWBTN_CFG_USE_EVT_QUEUE || LWBTN_CFG_USE_EVT_BATCH || LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Single-producer/single-consumer event queue
+ * 
+ * Processing function is the only writer of the records and write index,
+ * \ref lwbtn_poll_event is the only writer of read index.
+ */
+typedef struct {
+    lwbtn_evt_rec_t* recs;     /*!< Records array. Set to `NULL` when queue is not used */
+    uint16_t size;             /*!< Number of records in array, power of `2` */
+    uint8_t policy;            /*!< Overflow policy, member of \ref lwbtn_evt_queue_policy_t */
+    volatile uint16_t w;       /*!< Free running write index */
+    volatile uint16_t r;       /*!< Free running read index */
+    volatile uint32_t dropped; /*!< Number of events lost due to overflow */
+} lwbtn_evt_queue_t;
+
+#endif /* LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Input edge record, stored to edge queue
+ */
+typedef struct {
+    lwbtn_time_t time; /*!< Time of the edge in milliseconds */
+    uint16_t btn_idx;  /*!< Button index in the group */
+    uint8_t state;     /*!< New input state, `1` when button is considered `active` */
+} lwbtn_edge_t;
+
+/**
+ * \brief           Single-producer/single-consumer input edge queue
+ *
+ * \ref lwbtn_push_edge is the only writer of the records and write index,
+ * processing function is the only writer of read index.
+ */
+typedef struct {
+    lwbtn_edge_t* edges;       /*!< Records array. Set to `NULL` when queue is not used */
+    uint16_t size;             /*!< Number of records in array, power of `2` */
+    volatile uint16_t w;       /*!< Free running write index */
+    volatile uint16_t r;       /*!< Free running read index */
+    volatile uint32_t dropped; /*!< Number of edges lost due to full queue */
+    lwbtn_time_t time_last;    /*!< Time of last group processing, edges are replayed from this time on */
+} lwbtn_edge_queue_t;
+
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__
+
+/**
+ * \brief           Timing wheel entry of one button
+ */
+typedef struct {
+    lwbtn_time_t deadline; /*!< Time at which button must be processed */
+    uint16_t next;         /*!< Index of next button in the same slot */
+    uint16_t prev;         /*!< Index of previous button in the same slot */
+} lwbtn_wheel_node_t;
+
+/**
+ * \brief           Hashed timing wheel, with one slot per millisecond
+ *
+ * Button is linked to slot `deadline % slots_cnt`. Slots, that have passed since last processing,
+ * are checked for expired buttons, that are then moved to the active set.
+ */
+typedef struct {
+    uint16_t* slots;           /*!< Index of first button in each slot. Set to `NULL` when wheel is not used */
+    lwbtn_wheel_node_t* nodes; /*!< Wheel entries, one per button */
+    uint16_t slots_cnt;        /*!< Number of slots, power of `2` */
+    lwbtn_time_t time;         /*!< Time, until which slots have been checked */
+} lwbtn_wheel_t;
+
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_TRACE || __DOXYGEN__
+
+/**
+ * \brief           Trace record type
+ */
+typedef enum {
+    LWBTN_TRACE_REC_INPUT = 0x00, /*!< Input state change of the button, value is new input state */
+    LWBTN_TRACE_REC_EVT,          /*!< Event sent for the button, value is member of \ref lwbtn_evt_t */
+    LWBTN_TRACE_REC_MARK,         /*!< Time mark, such as end of capture. Button index and value are not used */
+} lwbtn_trace_rec_type_t;
+
+/**
+ * \brief           Decoded trace record
+ */
+typedef struct {
+    lwbtn_time_t time; /*!< Time of the record in milliseconds */
+    uint16_t btn_idx;  /*!< Button index in the group */
+    uint8_t type;      /*!< Record type, member of \ref lwbtn_trace_rec_type_t */
+    uint8_t val;       /*!< Input state or event type */
+} lwbtn_trace_rec_t;
+
+/**
+ * \brief           Trace writer
+ *
+ * Every record stores time difference to previous record and button index as variable length integers
+ */
+typedef struct {
+    uint8_t* buff;     /*!< Trace data memory */
+    size_t size;       /*!< Size of trace data memory in bytes */
+    size_t len;        /*!< Number of written bytes */
+    lwbtn_time_t time; /*!< Time of last written record */
+    uint8_t overflow;  /*!< Set to `1` when record did not fit to memory. No more records are written after it */
+} lwbtn_trace_t;
+
+#endif /* LWBTN_CFG_USE_TRACE || __DOXYGEN__ */
+
 /**
  * \brief           Button event function callback prototype
  * \param[in]       lwobj: LwBTN instance
@@ -95,6 +311,41 @@ typedef enum {
  */
 typedef void (*lwbtn_evt_fn)(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt);
 
+#if LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__
+
+/**
+ * \brief           Event info function callback prototype
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       rec: Event record with button data captured at the time of event
+ */
+typedef void (*lwbtn_evt_info_fn)(struct lwbtn* lwobj, const lwbtn_evt_rec_t* rec);
+
+#endif /* LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__
+
+/**
+ * \brief           Batched events function callback prototype
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       recs: Events of the processing call, in order of generation
+ * \param[in]       recs_cnt: Number of events in array
+ */
+typedef void (*lwbtn_evt_batch_fn)(struct lwbtn* lwobj, const lwbtn_evt_rec_t* recs, uint16_t recs_cnt);
+
+/**
+ * \brief           Event batch, collecting events of one processing call
+ */
+typedef struct {
+    lwbtn_evt_rec_t* recs;           /*!< Records array. Set to `NULL` when batch is not used */
+    uint16_t size;                   /*!< Number of records in array */
+    uint16_t cnt;                    /*!< Number of collected events */
+    uint8_t delivering;              /*!< Set to `1` while events are delivered to the application */
+    uint32_t dropped;                /*!< Number of events lost due to full batch */
+    lwbtn_evt_batch_fn evt_batch_fn; /*!< Batched events function. Events are sent one by one when `NULL` */
+} lwbtn_evt_batch_t;
+
+#endif /* LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__ */
+
 /**
  * \brief           Get button/input state callback function
  * \param[in]       lwobj: LwBTN instance
@@ -103,36 +354,209 @@ typedef void (*lwbtn_evt_fn)(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_e
  */
 typedef uint8_t (*lwbtn_get_state_fn)(struct lwbtn* lwobj, struct lwbtn_btn* btn);
 
+/**
+ * \brief           Get input states of the whole group callback function
+ * \param[in]       lwobj: LwBTN instance
+ * \param[out]      mask: Bit mask to fill. Bit `n` of word `w` belongs to button with index `w * LWBTN_WORD_BITS + n`,
+ *                      and is set to `1` when button is considered `active`
+ * \param[in]       words_cnt: Number of words in the mask
+ */
+typedef void (*lwbtn_get_state_mask_fn)(struct lwbtn* lwobj, lwbtn_word_t* mask, uint16_t words_cnt);
+
+/**
+ * \brief           Set timer callback function
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       status: \ref LWBTN_DEADLINE_PENDING to arm the timer,
+ *                      \ref LWBTN_DEADLINE_IDLE to stop it, as group waits for next input edge
+ * \param[in]       time: Absolute time in milliseconds to process the group at, valid when timer is armed
+ */
+typedef void (*lwbtn_set_timer_fn)(struct lwbtn* lwobj, lwbtn_deadline_t status, lwbtn_time_t time);
+
+#if LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__
+
+/**
+ * \brief           Get button/input state by index callback function
+ * \param[in]       user: User context of the group
+ * \param[in]       btn_idx: Button index in the group
+ * \return          `1` when button is considered `active`, `0` otherwise
+ */
+typedef uint8_t (*lwbtn_get_state_idx_fn)(void* user, uint16_t btn_idx);
+
+/**
+ * \brief           Button event by index callback function
+ * \param[in]       user: User context of the group
+ * \param[in]       btn_idx: Button index in the group
+ * \param[in]       evt: Button event
+ */
+typedef void (*lwbtn_evt_idx_fn)(void* user, uint16_t btn_idx, lwbtn_evt_t evt);
+
+#endif /* LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__ */
+
+/**
+ * \brief           Set to `1` when any button parameter is configured as dynamic
+ */
+#define LWBTN_PARAMS_DYNAMIC                                                                                           \
+    (!LWBTN_CFG_USE_PROFILES                                                                                           \
+     && (LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC                              \
+         || LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC || LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC                                       \
+         || LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC || LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC                          \
+         || LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC))
+
+#if LWBTN_CFG_USE_PROFILES || __DOXYGEN__
+
+/**
+ * \brief           Timing profile, shared by all buttons of the same timing class
+ * \sa              lwbtn_profiles_init, LWBTN_PROFILE_DEFAULT
+ */
+typedef struct {
+    uint16_t time_debounce;          /*!< Debounce time in milliseconds */
+    uint16_t time_debounce_release;  /*!< Debounce time in milliseconds for release event */
+    uint16_t time_click_pressed_min; /*!< Minimum pressed time for valid click event */
+    uint16_t time_click_pressed_max; /*!< Maximum pressed time for valid click event */
+    uint16_t time_click_multi_max;   /*!< Maximum time between 2 clicks to be considered consecutive click */
+    uint16_t time_keepalive_period;  /*!< Time in ms for periodic keep alive event */
+    uint16_t max_consecutive;        /*!< Max number of consecutive clicks */
+} lwbtn_profile_t;
+
+/**
+ * \brief           Initializer of \ref lwbtn_profile_t with default values from the configuration
+ */
+#define LWBTN_PROFILE_DEFAULT                                                                                          \
+    {                                                                                                                  \
+        LWBTN_CFG_TIME_DEBOUNCE_PRESS, LWBTN_CFG_TIME_DEBOUNCE_RELEASE, LWBTN_CFG_TIME_CLICK_MIN,                      \
+            LWBTN_CFG_TIME_CLICK_MAX, LWBTN_CFG_TIME_CLICK_MULTI_MAX, LWBTN_CFG_TIME_KEEPALIVE_PERIOD,                 \
+            LWBTN_CFG_CLICK_MAX_CONSECUTIVE,                                                                           \
+    }
+
+#endif /* LWBTN_CFG_USE_PROFILES || __DOXYGEN__ */
+
+#if (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__
+
+/**
+ * \brief           Dynamic parameters of the button, when \ref LWBTN_CFG_USE_COMPACT is enabled
+ *
+ * Parameters are kept in separate array of the group, with entry `n` belonging to button `n`
+ * \sa              lwbtn_params_init
+ */
+typedef struct {
+#if LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || __DOXYGEN__
+    uint16_t time_debounce; /*!< Debounce time in milliseconds */
+#endif                      /* LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || __DOXYGEN__ */
+#if LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC || __DOXYGEN__
+    uint16_t time_debounce_release; /*!< Debounce time in milliseconds for release event  */
+#endif                              /* LWBTN_CFG_TIME_DEBOUNCE_RELEASE */
+#if LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC || __DOXYGEN__
+    uint16_t time_click_pressed_min; /*!< Minimum pressed time for valid click event */
+#endif                               /* LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC || __DOXYGEN__ */
+#if LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC || __DOXYGEN__
+    uint16_t time_click_pressed_max; /*!< Maximum pressed time for valid click event*/
+#endif                               /* LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC || __DOXYGEN__ */
+#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC || __DOXYGEN__
+    uint16_t time_click_multi_max; /*!< Maximum time between 2 clicks to be considered consecutive click */
+#endif                             /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC || __DOXYGEN__ */
+#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC || __DOXYGEN__
+    uint16_t time_keepalive_period; /*!< Time in ms for periodic keep alive event */
+#endif                              /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC || __DOXYGEN__ */
+#if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC || __DOXYGEN__
+    uint16_t max_consecutive; /*!< Max number of consecutive clicks */
+#endif                        /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC || __DOXYGEN__ */
+} lwbtn_btn_params_t;
+
+#endif /* (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_DESCRIPTORS || LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__
+
+#define LWBTN_BTN_FEATURE_CLICK     ((uint8_t)0x01) /*!< Button detects clicks and sends on-click event */
+#define LWBTN_BTN_FEATURE_KEEPALIVE ((uint8_t)0x02) /*!< Button sends keep alive events while pressed */
+#define LWBTN_BTN_FEATURES_ALL      (LWBTN_BTN_FEATURE_CLICK | LWBTN_BTN_FEATURE_KEEPALIVE) /*!< All features */
+
+#endif /* LWBTN_CFG_USE_DESCRIPTORS || LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__
+
+/**
+ * \brief           Constant button descriptor, that can be placed to flash memory
+ *
+ * Descriptors are kept in separate array of the group, with entry `n` belonging to button `n`.
+ * Button without any feature flag only sends on-press and on-release events.
+ * \sa              lwbtn_descs_init, lwbtn_get_btn_desc
+ */
+typedef struct {
+    void* arg;      /*!< User defined custom argument for callback function purpose */
+    uint16_t input; /*!< User defined input number, for example GPIO pin or bit in input register */
+#if LWBTN_CFG_USE_PROFILES || __DOXYGEN__
+    uint8_t profile; /*!< Index of timing profile in the table of the group */
+#endif               /* LWBTN_CFG_USE_PROFILES || __DOXYGEN__ */
+    uint8_t features; /*!< Enabled features, bitwise OR of `LWBTN_BTN_FEATURE_*` flags */
+} lwbtn_btn_desc_t;
+
+#endif /* LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__ */
+
 /**
  * \brief           Button/input structure
  */
 typedef struct lwbtn_btn {
+#if LWBTN_CFG_USE_COMPACT
+    uint8_t flags; /*!< Private button flags management, including last button state */
+#else
     uint16_t flags; /*!< Private button flags management */
+#endif /* LWBTN_CFG_USE_COMPACT */
 #if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK || __DOXYGEN__
-    uint8_t curr_state;             /*!< Current button state to be processed. It is used 
+    uint8_t curr_state; /*!< Current button state to be processed. It is used 
                                     to keep track when application manually sets the button state */
-#endif                              /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK || __DOXYGEN__ */
-    uint8_t last_state;             /*!< Last button state - `1` means active, `0` means inactive */
-    lwbtn_time_t time_change;       /*!< Time in ms when button state got changed last time after valid debounce */
-    lwbtn_time_t time_state_change; /*!< Time in ms when button state got changed last time */
+#endif                  /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK || __DOXYGEN__ */
+#if !LWBTN_CFG_USE_COMPACT || __DOXYGEN__
+    uint8_t last_state; /*!< Last button state - `1` means active, `0` means inactive */
+#endif                  /* !LWBTN_CFG_USE_COMPACT || __DOXYGEN__ */
+#if (LWBTN_CFG_USE_PROFILES && !LWBTN_CFG_USE_DESCRIPTORS) || __DOXYGEN__
+    uint8_t profile; /*!< Index of timing profile in the table of the group */
+#endif               /* (LWBTN_CFG_USE_PROFILES && !LWBTN_CFG_USE_DESCRIPTORS) || __DOXYGEN__ */
+    lwbtn_btn_time_t time_change;       /*!< Time in ms when button state got changed last time after valid debounce */
+    lwbtn_btn_time_t time_state_change; /*!< Time in ms when button state got changed last time */
 
 #if LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__
     struct {
-        lwbtn_time_t last_time; /*!< Time in ms of last send keep alive event */
+#if !LWBTN_CFG_USE_COMPACT || __DOXYGEN__
+        lwbtn_time_t last_time; /*!< Time in ms of last send keep alive event.
+                                    Calculated from press time and counter when \ref LWBTN_CFG_USE_COMPACT is enabled */
+#endif                          /* !LWBTN_CFG_USE_COMPACT || __DOXYGEN__ */
         uint16_t cnt;           /*!< Number of keep alive events sent after successful on-press detection.
                                     Value is reset after on-release */
+#if LWBTN_CFG_KEEPALIVE_COALESCE || __DOXYGEN__
+        uint16_t evt_periods;   /*!< Number of keep alive periods reported by last keep alive event */
+#endif                          /* LWBTN_CFG_KEEPALIVE_COALESCE || __DOXYGEN__ */
     } keepalive;                /*!< Keep alive structure */
 #endif                          /* LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__ */
 
 #if LWBTN_CFG_USE_CLICK || __DOXYGEN__
     struct {
-        lwbtn_time_t last_time; /*!< Time in ms of last successfully detected (not sent!) click event */
-        uint8_t cnt;            /*!< Number of consecutive clicks detected, respecting maximum timeout between clicks */
-    } click;                    /*!< Click event structure */
-#endif                          /* LWBTN_CFG_USE_CLICK || __DOXYGEN__ */
+        lwbtn_btn_time_t last_time; /*!< Time in ms of last successfully detected (not sent!) click event */
+        uint8_t cnt; /*!< Number of consecutive clicks detected, respecting maximum timeout between clicks */
+    } click;         /*!< Click event structure */
+#endif               /* LWBTN_CFG_USE_CLICK || __DOXYGEN__ */
 
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__
+    struct {
+        lwbtn_btn_time_t start; /*!< Time in ms of first input change of the bounce being measured */
+        uint16_t bounce;        /*!< Running percentile of bounce durations in `1/64` ms,
+                                        or sum of first bounce durations in ms, while debounce time is `0` */
+        uint8_t time;           /*!< Effective press debounce time in ms. `0` until first bounces are measured */
+        uint8_t samples;        /*!< Number of measured bounces, until debounce time is set */
+        uint8_t measuring;      /*!< Set to `1` while bounce is being measured */
+    } debounce;                 /*!< Adaptive debounce structure */
+#endif                          /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__ */
+
+#if !LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__
     void* arg; /*!< User defined custom argument for callback function purpose */
+#endif         /* !LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__
+    uint8_t evt_mask; /*!< Subscribed events, bitwise OR of \ref LWBTN_EVT_MASK values */
+#endif                /* LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__ */
+#if LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__
+    uint8_t features; /*!< Enabled features, bitwise OR of `LWBTN_BTN_FEATURE_*` flags */
+#endif                /* LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__ */
 
+#if (!LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__
 #if LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || __DOXYGEN__
     uint16_t time_debounce; /*!< Debounce time in milliseconds */
 #endif                      /* LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || __DOXYGEN__ */
@@ -154,6 +578,7 @@ typedef struct lwbtn_btn {
 #if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC || __DOXYGEN__
     uint16_t max_consecutive; /*!< Max number of consecutive clicks */
 #endif                        /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC || __DOXYGEN__ */
+#endif /* (!LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__ */
 } lwbtn_btn_t;
 
 /**
@@ -166,6 +591,61 @@ typedef struct lwbtn {
 #if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL || __DOXYGEN__
     lwbtn_get_state_fn get_state_fn; /*!< Pointer to get state function */
 #endif                               /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL || __DOXYGEN__ */
+#if LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__
+    lwbtn_word_t* active; /*!< Bitmap of non-idle buttons. Set to `NULL` to process all buttons */
+#endif                    /* LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__ */
+#if LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__
+    lwbtn_word_t* state_mask;                  /*!< Current and previous group input states. `NULL` when not used */
+    lwbtn_get_state_mask_fn get_state_mask_fn; /*!< Pointer to get group state mask function */
+#endif                                         /* LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__
+    lwbtn_evt_queue_t evt_queue; /*!< Event queue */
+#endif                           /* LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__
+    lwbtn_evt_batch_t evt_batch; /*!< Event batch */
+#endif                           /* LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__
+    lwbtn_evt_info_fn evt_info_fn; /*!< Event info function, used instead of event function */
+#endif                             /* LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__ */
+#if LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__
+    void* user;                              /*!< User context of the group, passed to index callbacks */
+    lwbtn_get_state_idx_fn get_state_idx_fn; /*!< Get state by index function, used instead of get state function */
+    lwbtn_evt_idx_fn evt_idx_fn;             /*!< Event by index function, used instead of event function */
+#endif                                       /* LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__
+    const lwbtn_evt_fn* evt_fns; /*!< Table of \ref LWBTN_EVT_CNT event functions, one per event type.
+                                    Set to `NULL` to use event function */
+#endif                           /* LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__ */
+#if LWBTN_CFG_USE_PARALLEL || __DOXYGEN__
+    struct lwbtn_par* par; /*!< Parallel processing instance. Only set while workers process the group */
+#endif                     /* LWBTN_CFG_USE_PARALLEL || __DOXYGEN__ */
+#if (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__
+    lwbtn_btn_params_t* params; /*!< Dynamic parameters of the buttons. Default values are used when `NULL` */
+#endif                          /* (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__ */
+#if LWBTN_CFG_USE_PROFILES || __DOXYGEN__
+    const lwbtn_profile_t* profiles; /*!< Timing profiles table */
+    uint8_t profiles_cnt;            /*!< Number of profiles in the table */
+#endif                               /* LWBTN_CFG_USE_PROFILES || __DOXYGEN__ */
+#if LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__
+    const lwbtn_btn_desc_t* descs; /*!< Constant descriptors of the buttons. Default descriptor is used when `NULL` */
+#endif                             /* LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__
+    lwbtn_edge_queue_t edge_queue; /*!< Input edge queue */
+#endif                             /* LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__ */
+#if LWBTN_CFG_USE_TIMER || __DOXYGEN__
+    lwbtn_set_timer_fn set_timer_fn; /*!< Pointer to set timer function. Set to `NULL` when not used */
+    lwbtn_time_t timer_time;         /*!< Time the timer is armed for */
+    lwbtn_time_t timer_mstime;       /*!< System time of last timer update */
+    uint8_t timer_status;            /*!< Timer status, member of \ref lwbtn_deadline_t */
+#endif                               /* LWBTN_CFG_USE_TIMER || __DOXYGEN__ */
+#if LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__
+    lwbtn_wheel_t wheel; /*!< Timing wheel of pending button deadlines */
+#endif                   /* LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__ */
+#if LWBTN_CFG_USE_TRACE || __DOXYGEN__
+    lwbtn_trace_t* trace;        /*!< Trace to record inputs and events to. Set to `NULL` when not used */
+    lwbtn_word_t* trace_states;  /*!< Last recorded input states, one bit per button */
+    lwbtn_word_t* replay_states; /*!< Input states of the buttons while trace is replayed, `NULL` otherwise */
+#endif                           /* LWBTN_CFG_USE_TRACE || __DOXYGEN__ */
 } lwbtn_t;
 
 uint8_t lwbtn_init_ex(lwbtn_t* lwobj, lwbtn_btn_t* btns, uint16_t btns_cnt, lwbtn_get_state_fn get_state_fn,
@@ -175,6 +655,69 @@ uint8_t lwbtn_process_btn_ex(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t msti
 uint8_t lwbtn_set_btn_state(lwbtn_btn_t* btn, uint8_t state);
 uint8_t lwbtn_is_btn_active(const lwbtn_btn_t* btn);
 uint8_t lwbtn_reset(lwbtn_t* lwobj, lwbtn_btn_t* btn);
+lwbtn_deadline_t lwbtn_get_next_deadline(lwbtn_t* lwobj, lwbtn_time_t mstime, lwbtn_time_t* deadline);
+#if LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__
+uint8_t lwbtn_active_set_init(lwbtn_t* lwobj, lwbtn_word_t* bitmap);
+uint8_t lwbtn_notify_btn_change(lwbtn_t* lwobj, lwbtn_btn_t* btn);
+#endif /* LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__ */
+#if LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__
+uint8_t lwbtn_state_mask_init(lwbtn_t* lwobj, lwbtn_word_t* mask, lwbtn_get_state_mask_fn get_state_mask_fn);
+uint8_t lwbtn_set_group_state_mask(lwbtn_t* lwobj, const lwbtn_word_t* mask);
+#endif /* LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__
+uint8_t lwbtn_evt_queue_init(lwbtn_t* lwobj, lwbtn_evt_rec_t* recs, uint16_t size, lwbtn_evt_queue_policy_t policy);
+uint8_t lwbtn_poll_event(lwbtn_t* lwobj, lwbtn_evt_rec_t* rec);
+#endif /* LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__
+uint8_t lwbtn_evt_batch_init(lwbtn_t* lwobj, lwbtn_evt_rec_t* recs, uint16_t size, lwbtn_evt_batch_fn evt_batch_fn);
+#endif /* LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__
+uint8_t lwbtn_evt_info_init(lwbtn_t* lwobj, lwbtn_evt_info_fn evt_info_fn);
+#endif /* LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__ */
+#if LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__
+uint8_t lwbtn_idx_callbacks_init(lwbtn_t* lwobj, void* user, lwbtn_get_state_idx_fn get_state_idx_fn,
+                                 lwbtn_evt_idx_fn evt_idx_fn);
+#endif /* LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__
+uint8_t lwbtn_set_btn_evt_mask(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t evt_mask);
+uint8_t lwbtn_evt_fns_init(lwbtn_t* lwobj, const lwbtn_evt_fn* evt_fns);
+#endif /* LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__ */
+#if LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__
+uint8_t lwbtn_set_btn_features(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t features);
+#endif /* LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__ */
+#if LWBTN_CFG_USE_TRACE || __DOXYGEN__
+uint8_t lwbtn_trace_init(lwbtn_trace_t* trace, uint8_t* buff, size_t size);
+uint8_t lwbtn_trace_write(lwbtn_trace_t* trace, const lwbtn_trace_rec_t* rec);
+uint8_t lwbtn_trace_read(const uint8_t* data, size_t len, size_t* pos, lwbtn_trace_rec_t* rec);
+uint8_t lwbtn_trace_attach(lwbtn_t* lwobj, lwbtn_trace_t* trace, lwbtn_word_t* states);
+uint8_t lwbtn_trace_replay(lwbtn_t* lwobj, const uint8_t* data, size_t len, lwbtn_word_t* states);
+#endif /* LWBTN_CFG_USE_TRACE || __DOXYGEN__ */
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__
+uint16_t lwbtn_get_btn_debounce(lwbtn_t* lwobj, const lwbtn_btn_t* btn);
+#endif /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__ */
+#if (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__
+uint8_t lwbtn_params_init(lwbtn_t* lwobj, lwbtn_btn_params_t* params);
+#endif /* (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__ */
+#if LWBTN_CFG_USE_PROFILES || __DOXYGEN__
+uint8_t lwbtn_profiles_init(lwbtn_t* lwobj, const lwbtn_profile_t* profiles, uint8_t profiles_cnt);
+#endif /* LWBTN_CFG_USE_PROFILES || __DOXYGEN__ */
+#if (LWBTN_CFG_USE_PROFILES && !LWBTN_CFG_USE_DESCRIPTORS) || __DOXYGEN__
+uint8_t lwbtn_set_btn_profile(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t profile);
+#endif /* (LWBTN_CFG_USE_PROFILES && !LWBTN_CFG_USE_DESCRIPTORS) || __DOXYGEN__ */
+#if LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__
+uint8_t lwbtn_descs_init(lwbtn_t* lwobj, const lwbtn_btn_desc_t* descs);
+const lwbtn_btn_desc_t* lwbtn_get_btn_desc(lwbtn_t* lwobj, const lwbtn_btn_t* btn);
+#endif /* LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__ */
+#if LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__
+uint8_t lwbtn_edge_queue_init(lwbtn_t* lwobj, lwbtn_edge_t* edges, uint16_t size);
+uint8_t lwbtn_push_edge(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t state, lwbtn_time_t mstime);
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__ */
+#if LWBTN_CFG_USE_TIMER || __DOXYGEN__
+uint8_t lwbtn_timer_init(lwbtn_t* lwobj, lwbtn_set_timer_fn set_timer_fn);
+#endif /* LWBTN_CFG_USE_TIMER || __DOXYGEN__ */
+#if LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__
+uint8_t lwbtn_wheel_init(lwbtn_t* lwobj, uint16_t* slots, uint16_t slots_cnt, lwbtn_wheel_node_t* nodes);
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__ */
 
 /**
  * \brief           Initialize LwBTN library with buttons on default button group
@@ -204,19 +747,23 @@ uint8_t lwbtn_reset(lwbtn_t* lwobj, lwbtn_btn_t* btn);
 #define lwbtn_process_btn(btn, mstime)                   lwbtn_process_btn_ex(NULL, (btn), (mstime))
 
 #if LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__
-#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC || __DOXYGEN__
+#if (LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC && !LWBTN_CFG_USE_COMPACT && !LWBTN_CFG_USE_PROFILES) || __DOXYGEN__
 
 /**
  * \brief           Get keep alive period for specific button
+ * \note            Not available when period is stored outside of the button,
+ *                      with \ref LWBTN_CFG_USE_PROFILES enabled, or with dynamic period
+ *                      and \ref LWBTN_CFG_USE_COMPACT enabled
  * \param[in]       btn: Button instance to get keep alive period for
  * \return          Keep alive period in `ms`
  */
 #define lwbtn_keepalive_get_period(btn) ((btn)->time_keepalive_period)
 
-#else
+#elif !LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC && !LWBTN_CFG_USE_PROFILES
 /* Default config */
 #define lwbtn_keepalive_get_period(btn) (LWBTN_CFG_TIME_KEEPALIVE_PERIOD)
-#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC || __DOXYGEN__ */
+#endif /* (LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC && !LWBTN_CFG_USE_COMPACT && !LWBTN_CFG_USE_PROFILES)
+          || __DOXYGEN__ */
 
 /**
  * \brief           Get actual number of keep alive counts since the last on-press event.
@@ -227,6 +774,19 @@ uint8_t lwbtn_reset(lwbtn_t* lwobj, lwbtn_btn_t* btn);
  */
 #define lwbtn_keepalive_get_count(btn)                   ((btn)->keepalive.cnt)
 
+#if LWBTN_CFG_KEEPALIVE_COALESCE || __DOXYGEN__
+
+/**
+ * \brief           Get number of keep alive periods reported by last keep alive event.
+ *                  Value greater than `1` means that processing was late and missed periods were coalesced
+ * \note            Available only when \ref LWBTN_CFG_KEEPALIVE_COALESCE is enabled
+ * \param[in]       btn: Button instance
+ * \return          Number of keep alive periods of last keep alive event
+ */
+#define lwbtn_keepalive_get_evt_periods(btn) ((btn)->keepalive.evt_periods)
+
+#endif /* LWBTN_CFG_KEEPALIVE_COALESCE || __DOXYGEN__ */
+
 /**
  * \brief           Get number of keep alive counts for specific required time in milliseconds.
  *                  It will calculate number of keepalive ticks specific button shall make,
@@ -254,6 +814,133 @@ uint8_t lwbtn_reset(lwbtn_t* lwobj, lwbtn_btn_t* btn);
  */
 #define lwbtn_click_get_count(btn) ((btn)->click.cnt)
 
+#if LWBTN_CFG_USE_BITSLICE || __DOXYGEN__
+
+/**
+ * \brief           Number of buttons handled by single bit-sliced block
+ */
+#define LWBTN_BS_BLOCK_BTNS              LWBTN_WORD_BITS
+
+/**
+ * \brief           Get number of bit-sliced blocks required for specific number of buttons
+ * \param[in]       btns_cnt: Number of buttons in the group
+ * \return          Number of \ref lwbtn_bs_block_t entries to allocate
+ */
+#define LWBTN_BS_BLOCKS_CNT(btns_cnt)    LWBTN_BITMAP_WORDS(btns_cnt)
+
+/* Forward declaration */
+struct lwbtn_bs;
+
+/**
+ * \brief           Bit-sliced block, holding state planes for \ref LWBTN_BS_BLOCK_BTNS buttons.
+ * 
+ * Bit `n` in every plane of block `b` belongs to button with index `b * LWBTN_BS_BLOCK_BTNS + n`.
+ * Timing values are stored as separate arrays (structure of arrays), with entry `n`
+ * belonging to the same button, to be compared against current time for all buttons at once.
+ */
+typedef struct {
+    lwbtn_word_t input; /*!< Raw input states set by application. `1` means active */
+    lwbtn_word_t last;  /*!< Last processed input states */
+    lwbtn_word_t ready; /*!< First inactive state has been received */
+    lwbtn_word_t sent;  /*!< On-press event has been sent */
+#if LWBTN_CFG_USE_CLICK || __DOXYGEN__
+    lwbtn_word_t click; /*!< At least one click is pending to be reported */
+#endif                  /* LWBTN_CFG_USE_CLICK || __DOXYGEN__ */
+    lwbtn_word_t cnt[LWBTN_CFG_BITSLICE_CNT_BITS]; /*!< Vertical counter of processing calls since last input change */
+#if LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__
+    lwbtn_time_t keepalive_time[LWBTN_BS_BLOCK_BTNS]; /*!< Time of last keep alive event, per button */
+#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC || __DOXYGEN__
+    lwbtn_time_t keepalive_period[LWBTN_BS_BLOCK_BTNS]; /*!< Keep alive period, latched at on-press event */
+#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC || __DOXYGEN__ */
+#endif /* LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__ */
+#if LWBTN_CFG_USE_CLICK || __DOXYGEN__
+    lwbtn_time_t click_time[LWBTN_BS_BLOCK_BTNS]; /*!< Time of last detected click, per button */
+#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC || __DOXYGEN__
+    lwbtn_time_t click_period[LWBTN_BS_BLOCK_BTNS]; /*!< Multi-click timeout, latched at click detection */
+#endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC || __DOXYGEN__ */
+#endif /* LWBTN_CFG_USE_CLICK || __DOXYGEN__ */
+} lwbtn_bs_block_t;
+
+/**
+ * \brief           Get input states of one bit-sliced block callback function
+ * \param[in]       lwbs: Bit-sliced LwBTN instance
+ * \param[in]       block_idx: Block index to read the states for
+ * \return          Bit mask of input states, bit set to `1` when button is considered `active`
+ */
+typedef lwbtn_word_t (*lwbtn_bs_get_input_fn)(struct lwbtn_bs* lwbs, uint16_t block_idx);
+
+/**
+ * \brief           Bit-sliced LwBTN group structure
+ * 
+ * Event callback receives pointer to \ref lwbtn_bs_t::lw member as group instance
+ */
+typedef struct lwbtn_bs {
+    lwbtn_t lw;                         /*!< Base group with buttons array and event function */
+    lwbtn_bs_block_t* blocks;           /*!< Pointer to bit-sliced blocks array */
+    uint16_t blocks_cnt;                /*!< Number of blocks in array */
+    lwbtn_bs_get_input_fn get_input_fn; /*!< Pointer to get input function. When `NULL`,
+                                            application sets inputs with \ref lwbtn_bs_set_input */
+    uint8_t cnt_press;                  /*!< Number of processing calls for valid press debounce */
+    uint8_t cnt_release;                /*!< Number of processing calls for valid release debounce */
+} lwbtn_bs_t;
+
+uint8_t lwbtn_bs_init(lwbtn_bs_t* lwbs, lwbtn_btn_t* btns, uint16_t btns_cnt, lwbtn_bs_block_t* blocks,
+                      lwbtn_time_t period, lwbtn_bs_get_input_fn get_input_fn, lwbtn_evt_fn evt_fn);
+uint8_t lwbtn_bs_process(lwbtn_bs_t* lwbs, lwbtn_time_t mstime);
+uint8_t lwbtn_bs_set_input(lwbtn_bs_t* lwbs, uint16_t block_idx, lwbtn_word_t input);
+uint8_t lwbtn_bs_reset(lwbtn_bs_t* lwbs, lwbtn_btn_t* btn);
+
+#endif /* LWBTN_CFG_USE_BITSLICE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_PARALLEL || __DOXYGEN__
+
+/**
+ * \brief           Event buffered during parallel processing, with button data at the time of event
+ */
+typedef struct {
+    uint16_t btn_idx;       /*!< Button index in the group */
+    uint16_t flags;         /*!< Button flags at the time of event */
+    uint16_t keepalive_cnt; /*!< Keep alive counter at the time of event */
+    uint8_t click_cnt;      /*!< Click counter at the time of event */
+    uint8_t evt;            /*!< Event type, member of \ref lwbtn_evt_t */
+} lwbtn_par_evt_t;
+
+/**
+ * \brief           Shard of the buttons array, processed by one worker at a time
+ */
+typedef struct {
+    lwbtn_par_evt_t* evts; /*!< Events generated by last processing of the shard */
+    size_t evts_cnt;       /*!< Number of events in buffer */
+    size_t evts_size;      /*!< Buffer size in units of events */
+} lwbtn_par_shard_t;
+
+/**
+ * \brief           Parallel processing instance of the group
+ */
+typedef struct lwbtn_par {
+    lwbtn_t* lwobj;             /*!< Group to process */
+    lwbtn_par_shard_t* shards;  /*!< Shards array */
+    uint16_t shards_cnt;        /*!< Number of shards */
+    uint16_t shard_btns;        /*!< Number of buttons in one shard */
+    pthread_t* workers;         /*!< Worker threads */
+    uint16_t workers_cnt;       /*!< Number of worker threads */
+    pthread_mutex_t mutex;      /*!< Mutex protecting work distribution */
+    pthread_cond_t cond_start;  /*!< Condition signaled when new processing round starts */
+    pthread_cond_t cond_done;   /*!< Condition signaled when last worker finishes the round */
+    uint32_t round;             /*!< Processing round counter */
+    uint16_t shard_next;        /*!< Next shard to be claimed by a worker */
+    uint16_t workers_busy;      /*!< Number of workers still in current round */
+    lwbtn_time_t mstime;        /*!< Time of current round */
+    uint32_t dropped;           /*!< Number of events lost due to failed memory allocation */
+    uint8_t stop;               /*!< Workers shall exit */
+} lwbtn_par_t;
+
+uint8_t lwbtn_par_init(lwbtn_par_t* lwpar, lwbtn_t* lwobj, uint16_t workers_cnt);
+uint8_t lwbtn_par_process(lwbtn_par_t* lwpar, lwbtn_time_t mstime);
+uint8_t lwbtn_par_deinit(lwbtn_par_t* lwpar);
+
+#endif /* LWBTN_CFG_USE_PARALLEL || __DOXYGEN__ */
+
 /**
  * \}
  */
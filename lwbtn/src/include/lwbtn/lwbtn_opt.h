@@ -70,6 +70,21 @@ extern "C" {
 #define LWBTN_MEMCPY(dst, src, len) memcpy((dst), (src), (len))
 #endif
 
+/**
+ * \brief           Full memory barrier
+ * 
+ * Used to order memory accesses between contexts, for instance between event record write and queue index update.
+ * Default implementation is available for GCC compatible compilers.
+ * Set it to platform specific instruction (for example `__DMB()` on Cortex-M), when other compiler is used.
+ */
+#ifndef LWBTN_MEMORY_BARRIER
+#if defined(__GNUC__) || defined(__clang__)
+#define LWBTN_MEMORY_BARRIER() __sync_synchronize()
+#else
+#define LWBTN_MEMORY_BARRIER()
+#endif /* defined(__GNUC__) || defined(__clang__) */
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` periodic keep alive events.
  * 
@@ -361,6 +376,417 @@ extern "C" {
 #define LWBTN_CFG_TIME_VARTYPE uint32_t
 #endif
 
+/**
+ * \brief           Word type used for button bit masks
+ * 
+ * Each word holds one bit for each of `8 * sizeof(type)` buttons.
+ * It is used for bit-sliced group planes and active set bitmap.
+ * Typically set to `uint32_t` or `uint64_t`, depending on the native CPU word.
+ */
+#ifndef LWBTN_CFG_WORD_TYPE
+#define LWBTN_CFG_WORD_TYPE uint32_t
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` active set processing of button group
+ * 
+ * When enabled, group can keep a bitmap of non-idle buttons (in debounce, pressed or waiting for click timeout).
+ * Only those are processed, while idle buttons are skipped until application notifies the group about input change.
+ * Processing time therefore scales with button activity instead of number of buttons.
+ * 
+ * \sa              lwbtn_active_set_init, lwbtn_notify_btn_change
+ */
+#ifndef LWBTN_CFG_USE_ACTIVE_SET
+#define LWBTN_CFG_USE_ACTIVE_SET 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` group state mask input
+ * 
+ * When enabled, input states of the whole group can be provided as one bit mask,
+ * either with single callback function per processing call or set by the application.
+ * This replaces per-button get state function calls.
+ * 
+ * Mask is compared against previously processed mask, and buttons with changed input
+ * are added to the active set, when \ref LWBTN_CFG_USE_ACTIVE_SET is enabled.
+ * 
+ * \sa              lwbtn_state_mask_init, lwbtn_set_group_state_mask
+ */
+#ifndef LWBTN_CFG_USE_STATE_MASK
+#define LWBTN_CFG_USE_STATE_MASK 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` event queue of the group
+ * 
+ * When enabled, group can store events to single-producer/single-consumer ring buffer
+ * instead of calling event function from processing function.
+ * Application then reads events with \ref lwbtn_poll_event from another context, without locks.
+ * 
+ * \sa              lwbtn_evt_queue_init, lwbtn_poll_event
+ */
+#ifndef LWBTN_CFG_USE_EVT_QUEUE
+#define LWBTN_CFG_USE_EVT_QUEUE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` atomic access to data shared between contexts
+ * 
+ * When enabled, \ref lwbtn_set_btn_state and \ref lwbtn_notify_btn_change may be called
+ * from interrupts or other threads while the group is being processed, without critical sections.
+ * Button state is written with single atomic store, and active set bits are modified
+ * with atomic read-modify-write operations only.
+ * 
+ * Operations are implemented with `LWBTN_ATOMIC_*` macros. Default implementation uses
+ * `__atomic` builtins of GCC compatible compilers, following C11 memory model.
+ * Application can define them in the options file for other compilers,
+ * or to use critical sections on cores without atomic instructions.
+ * 
+ * \note            Active set words of \ref LWBTN_CFG_WORD_TYPE type must be supported by atomic operations
+ */
+#ifndef LWBTN_CFG_USE_ATOMIC
+#define LWBTN_CFG_USE_ATOMIC 0
+#endif
+
+#if (LWBTN_CFG_USE_ATOMIC && (defined(__GNUC__) || defined(__clang__))) || __DOXYGEN__
+
+/**
+ * \brief           Atomically load value with acquire ordering
+ * \param[in]       ptr: Pointer to variable
+ * \return          Variable value
+ */
+#ifndef LWBTN_ATOMIC_LOAD
+#define LWBTN_ATOMIC_LOAD(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#endif
+
+/**
+ * \brief           Atomically store value with release ordering
+ * \param[in]       ptr: Pointer to variable
+ * \param[in]       val: Value to store
+ */
+#ifndef LWBTN_ATOMIC_STORE
+#define LWBTN_ATOMIC_STORE(ptr, val)      __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#endif
+
+/**
+ * \brief           Atomically set bits in variable
+ * \param[in]       ptr: Pointer to variable
+ * \param[in]       val: Bits to set
+ */
+#ifndef LWBTN_ATOMIC_FETCH_OR
+#define LWBTN_ATOMIC_FETCH_OR(ptr, val)   ((void)__atomic_fetch_or((ptr), (val), __ATOMIC_ACQ_REL))
+#endif
+
+/**
+ * \brief           Atomically clear bits in variable
+ * \param[in]       ptr: Pointer to variable
+ * \param[in]       val: Mask of bits to keep
+ */
+#ifndef LWBTN_ATOMIC_FETCH_AND
+#define LWBTN_ATOMIC_FETCH_AND(ptr, val)  ((void)__atomic_fetch_and((ptr), (val), __ATOMIC_ACQ_REL))
+#endif
+
+#endif /* (LWBTN_CFG_USE_ATOMIC && (defined(__GNUC__) || defined(__clang__))) || __DOXYGEN__ */
+
+/**
+ * \brief           Enables `1` or disables `0` bit-sliced button group engine.
+ * 
+ * Bit-sliced group stores debounce, press and click state of the buttons as bit planes,
+ * where every bit in a word belongs to one button. Each processing call then updates
+ * whole word of buttons with few logical operations, and only drops to per-button
+ * processing for buttons that have an event (or pending timeout) to handle.
+ * 
+ * Debounce is implemented with vertical counters, counting number of processing calls
+ * since last input change. Processing function must therefore be called at fixed period.
+ * Debounce times are the same for all buttons of the group.
+ * 
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC
+ *                  and \ref LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC
+ * \sa              LWBTN_CFG_WORD_TYPE, LWBTN_CFG_BITSLICE_CNT_BITS
+ */
+#ifndef LWBTN_CFG_USE_BITSLICE
+#define LWBTN_CFG_USE_BITSLICE 0
+#endif
+
+/**
+ * \brief           Number of bit planes used for vertical debounce counter in bit-sliced group
+ * 
+ * Counter counts processing calls since last input change and saturates at debounce threshold.
+ * Maximum debounce is therefore `2^bits - 1` processing periods.
+ */
+#ifndef LWBTN_CFG_BITSLICE_CNT_BITS
+#define LWBTN_CFG_BITSLICE_CNT_BITS 5
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` SIMD kernels for bit-sliced group time comparisons
+ * 
+ * Keep alive and click timeout times of bit-sliced group are stored as separate arrays
+ * per block, and compared against current time for whole block at once.
+ * When enabled, `SSE2` or `AVX2` instructions are used, if target compiler supports them.
+ * Portable implementation is used otherwise.
+ */
+#ifndef LWBTN_CFG_BITSLICE_SIMD
+#define LWBTN_CFG_BITSLICE_SIMD 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` parallel processing of the group with POSIX threads
+ * 
+ * Intended for host systems with very large groups (simulation, test rigs).
+ * Buttons array is split into shards, processed by a pool of worker threads,
+ * and events are delivered in the same order as with \ref lwbtn_process_ex.
+ * 
+ * \note            Application must link with `pthread` library. Feature uses dynamic memory allocation
+ * \sa              lwbtn_par_init, lwbtn_par_process
+ */
+#ifndef LWBTN_CFG_USE_PARALLEL
+#define LWBTN_CFG_USE_PARALLEL 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` compact button structure
+ *
+ * Button times are stored as `16-bit` values, last state is kept in the flags,
+ * keep alive time is calculated from press time and keep alive counter,
+ * and dynamic parameters are moved out of the button, to separate array of the group.
+ *
+ * \note            Group must be processed at least once every `65` seconds,
+ *                      either periodically or at time returned by \ref lwbtn_get_next_deadline
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_BITSLICE
+ * \sa              lwbtn_params_init
+ */
+#ifndef LWBTN_CFG_USE_COMPACT
+#define LWBTN_CFG_USE_COMPACT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` shared timing profiles
+ *
+ * All timing parameters of the button are read from \ref lwbtn_profile_t table of the group,
+ * and each button only keeps index of its profile.
+ * Buttons with the same timing share single profile, which can be changed with single write.
+ *
+ * \note            When enabled, `*_DYNAMIC` parameter options have no effect
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_BITSLICE
+ * \sa              lwbtn_profiles_init, lwbtn_set_btn_profile
+ */
+#ifndef LWBTN_CFG_USE_PROFILES
+#define LWBTN_CFG_USE_PROFILES 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` constant button descriptors
+ *
+ * Configuration of the button (user argument, input number, timing profile and enabled features)
+ * is moved out of the button, to \ref lwbtn_btn_desc_t array of the group.
+ * Array is constant and can be placed to flash memory, while button keeps only its runtime state in RAM.
+ *
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_BITSLICE
+ * \sa              lwbtn_descs_init
+ */
+#ifndef LWBTN_CFG_USE_DESCRIPTORS
+#define LWBTN_CFG_USE_DESCRIPTORS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` coalescing of missed keep alive events
+ *
+ * When processing is late for more than one keep alive period, for example after long flash write,
+ * number of missed periods is calculated with single division and only one keep alive event is sent.
+ * Keep alive counter is advanced by all missed periods at once,
+ * and number of periods reported by the event is read with \ref lwbtn_keepalive_get_evt_periods.
+ *
+ * When disabled, one keep alive event is sent for every missed period.
+ */
+#ifndef LWBTN_CFG_KEEPALIVE_COALESCE
+#define LWBTN_CFG_KEEPALIVE_COALESCE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` timestamped input edge queue
+ *
+ * Input edges are written to lock-free queue of the group with \ref lwbtn_push_edge,
+ * usually from GPIO edge interrupts, together with exact time of the edge.
+ * Processing replays queued edges with their timestamps, including timeouts expiring between edges,
+ * so that timing resolution does not depend on processing period, and presses shorter than
+ * processing period are not lost.
+ *
+ * Button, that received at least one edge, takes its state from the edges only.
+ *
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_BITSLICE
+ * \sa              lwbtn_edge_queue_init, lwbtn_push_edge
+ */
+#ifndef LWBTN_CFG_USE_EDGE_QUEUE
+#define LWBTN_CFG_USE_EDGE_QUEUE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` timer arming callback of the group
+ *
+ * After every processing, group calculates its next deadline with \ref lwbtn_get_next_deadline
+ * and calls timer function set with \ref lwbtn_timer_init, when deadline has changed.
+ * Application arms one-shot timer with it, and only calls processing function
+ * on timer expiry and on input edges, instead of periodically.
+ *
+ * \sa              lwbtn_timer_init
+ */
+#ifndef LWBTN_CFG_USE_TIMER
+#define LWBTN_CFG_USE_TIMER 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` hashed timing wheel of pending button deadlines
+ *
+ * Buttons, that wait for debounce, keep alive or click timeout, are indexed in wheel slots
+ * by their next deadline, instead of being kept in active set.
+ * Processing only visits buttons from expired slots and buttons with input change,
+ * and next deadline of the group is found without scanning all buttons.
+ *
+ * \note            Feature requires \ref LWBTN_CFG_USE_ACTIVE_SET
+ *                      and cannot be used together with \ref LWBTN_CFG_USE_PARALLEL
+ * \sa              lwbtn_wheel_init
+ */
+#ifndef LWBTN_CFG_USE_TIMING_WHEEL
+#define LWBTN_CFG_USE_TIMING_WHEEL 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` batched event delivery
+ *
+ * Events are collected to the batch of the group while buttons are processed,
+ * and delivered after all buttons have been processed, either with single call
+ * to batched events function, or one by one to event function.
+ * Event function can therefore modify the group, for example reset the button,
+ * without interfering with processing in progress.
+ *
+ * \sa              lwbtn_evt_batch_init
+ */
+#ifndef LWBTN_CFG_USE_EVT_BATCH
+#define LWBTN_CFG_USE_EVT_BATCH 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` rich event records
+ *
+ * Event record \ref lwbtn_evt_rec_t additionally carries press duration
+ * and time since last click, captured at the time of event, next to its time and counters.
+ * Records are stored to event queue and event batch, or sent to event info function
+ * set with \ref lwbtn_evt_info_init, so that application does not need to read button data.
+ *
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_PARALLEL
+ * \sa              lwbtn_evt_info_init
+ */
+#ifndef LWBTN_CFG_USE_EVT_INFO
+#define LWBTN_CFG_USE_EVT_INFO 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` index callbacks with group user context
+ *
+ * Get state and event functions, set with \ref lwbtn_idx_callbacks_init,
+ * receive button index in the group and user context of the group, instead of button pointer.
+ * Application can index its own tables directly, without reading button custom argument.
+ *
+ * \sa              lwbtn_idx_callbacks_init
+ */
+#ifndef LWBTN_CFG_USE_IDX_CALLBACKS
+#define LWBTN_CFG_USE_IDX_CALLBACKS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` event subscription masks and event handler table
+ *
+ * Every button has mask of subscribed events, set with \ref lwbtn_set_btn_evt_mask.
+ * Events, that button is not subscribed to, are not sent, and their work is skipped in the state machine,
+ * such as keep alive timing or click detection.
+ * Group can also use table of event functions, one per event type, set with \ref lwbtn_evt_fns_init.
+ *
+ * \sa              lwbtn_set_btn_evt_mask, lwbtn_evt_fns_init
+ */
+#ifndef LWBTN_CFG_USE_EVT_MASK
+#define LWBTN_CFG_USE_EVT_MASK 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` runtime features of each button
+ *
+ * Every button has its own set of features, set with \ref lwbtn_set_btn_features,
+ * to detect clicks, to send keep alive events, both or none.
+ * Button without any feature takes short processing path, with debounce, on-press and on-release events only.
+ *
+ * \note            When \ref LWBTN_CFG_USE_DESCRIPTORS is enabled, button only uses features,
+ *                      that are enabled both in its descriptor and in the button
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_BITSLICE
+ * \sa              lwbtn_set_btn_features
+ */
+#ifndef LWBTN_CFG_USE_BTN_FEATURES
+#define LWBTN_CFG_USE_BTN_FEATURES 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` trace record and replay
+ *
+ * Group records its input state changes and sent events to compact binary trace, attached with \ref lwbtn_trace_attach.
+ * Recorded or imported trace is replayed through the group with \ref lwbtn_trace_replay,
+ * processing the group only at input changes and pending deadlines.
+ *
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_PARALLEL
+ * \sa              lwbtn_trace_init, lwbtn_trace_write, lwbtn_trace_read
+ */
+#ifndef LWBTN_CFG_USE_TRACE
+#define LWBTN_CFG_USE_TRACE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` adaptive press debounce time of every button
+ *
+ * Button measures duration of its input bounce, from first input change until the last one,
+ * after which input stays stable for current debounce time of the button.
+ * Press debounce time of the button follows running percentile of measured durations,
+ * increased by \ref LWBTN_CFG_ADAPTIVE_DEBOUNCE_MARGIN.
+ * Configured press debounce time is used until first `8` bounces are measured.
+ *
+ * Effective debounce time of the button can be read with \ref lwbtn_get_btn_debounce.
+ *
+ * \note            Feature cannot be used together with \ref LWBTN_CFG_USE_BITSLICE
+ */
+#ifndef LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE
+#define LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE 0
+#endif
+
+/**
+ * \brief           Percentile of measured bounce durations, that adaptive debounce time follows
+ *
+ * Value must be between `1` and `99`. Higher value filters longer bounces, that occur less often.
+ * Estimate goes up faster than down, switch that starts to bounce longer is followed quickly
+ *
+ * \note            Used when \ref LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE is enabled
+ */
+#ifndef LWBTN_CFG_ADAPTIVE_DEBOUNCE_PERCENTILE
+#define LWBTN_CFG_ADAPTIVE_DEBOUNCE_PERCENTILE 90
+#endif
+
+/**
+ * \brief           Time in milliseconds, added to percentile of bounce durations for adaptive debounce time
+ *
+ * \note            Used when \ref LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE is enabled
+ */
+#ifndef LWBTN_CFG_ADAPTIVE_DEBOUNCE_MARGIN
+#define LWBTN_CFG_ADAPTIVE_DEBOUNCE_MARGIN 2
+#endif
+
+/**
+ * \brief           Maximum adaptive debounce time and measured bounce duration, in milliseconds
+ *
+ * Value must not be more than `255`
+ *
+ * \note            Used when \ref LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE is enabled
+ */
+#ifndef LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW
+#define LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW 40
+#endif
+
 /**
  * \}
  */
@@ -34,10 +34,92 @@
 #include <string.h>
 #include "lwbtn/lwbtn.h"
 
+#if LWBTN_CFG_USE_PARALLEL
+#include <stdlib.h>
+#endif /* LWBTN_CFG_USE_PARALLEL */
+
+#if LWBTN_CFG_USE_BITSLICE && LWBTN_CFG_BITSLICE_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LWBTN_BS_USE_AVX2 1
+#endif /* defined(__AVX2__) */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LWBTN_BS_USE_SSE2 1
+#endif /* defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) */
+#endif /* LWBTN_CFG_USE_BITSLICE && LWBTN_CFG_BITSLICE_SIMD */
+
 #if LWBTN_CFG_GET_STATE_MODE > 2
 #error "Invalid LWBTN_GET_STATE_MODE_CALLBACK configuration"
 #endif
 
+#if LWBTN_CFG_USE_COMPACT && LWBTN_CFG_USE_BITSLICE
+#error "LWBTN_CFG_USE_COMPACT cannot be used together with LWBTN_CFG_USE_BITSLICE"
+#endif
+
+#if LWBTN_CFG_USE_PROFILES && LWBTN_CFG_USE_BITSLICE
+#error "LWBTN_CFG_USE_PROFILES cannot be used together with LWBTN_CFG_USE_BITSLICE"
+#endif
+
+#if LWBTN_CFG_USE_DESCRIPTORS && LWBTN_CFG_USE_BITSLICE
+#error "LWBTN_CFG_USE_DESCRIPTORS cannot be used together with LWBTN_CFG_USE_BITSLICE"
+#endif
+
+#if LWBTN_CFG_USE_BTN_FEATURES && LWBTN_CFG_USE_BITSLICE
+#error "LWBTN_CFG_USE_BTN_FEATURES cannot be used together with LWBTN_CFG_USE_BITSLICE"
+#endif
+
+#if (LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC) && LWBTN_CFG_USE_BITSLICE
+#error "LWBTN_CFG_TIME_DEBOUNCE_*_DYNAMIC cannot be used together with LWBTN_CFG_USE_BITSLICE"
+#endif
+
+#if LWBTN_CFG_USE_EDGE_QUEUE && LWBTN_CFG_USE_BITSLICE
+#error "LWBTN_CFG_USE_EDGE_QUEUE cannot be used together with LWBTN_CFG_USE_BITSLICE"
+#endif
+
+#if LWBTN_CFG_USE_TIMING_WHEEL && !LWBTN_CFG_USE_ACTIVE_SET
+#error "LWBTN_CFG_USE_TIMING_WHEEL requires LWBTN_CFG_USE_ACTIVE_SET"
+#endif
+
+#if LWBTN_CFG_USE_TIMING_WHEEL && LWBTN_CFG_USE_PARALLEL
+#error "LWBTN_CFG_USE_TIMING_WHEEL cannot be used together with LWBTN_CFG_USE_PARALLEL"
+#endif
+
+#if LWBTN_CFG_USE_EVT_INFO && LWBTN_CFG_USE_PARALLEL
+#error "LWBTN_CFG_USE_EVT_INFO cannot be used together with LWBTN_CFG_USE_PARALLEL"
+#endif
+
+#if LWBTN_CFG_USE_TRACE && LWBTN_CFG_USE_PARALLEL
+#error "LWBTN_CFG_USE_TRACE cannot be used together with LWBTN_CFG_USE_PARALLEL"
+#endif
+
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE && LWBTN_CFG_USE_BITSLICE
+#error "LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE cannot be used together with LWBTN_CFG_USE_BITSLICE"
+#endif
+
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE                                                                                    \
+    && (LWBTN_CFG_ADAPTIVE_DEBOUNCE_PERCENTILE < 1 || LWBTN_CFG_ADAPTIVE_DEBOUNCE_PERCENTILE > 99                      \
+        || LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW < 1 || LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW > 255)
+#error "Invalid LWBTN_CFG_ADAPTIVE_DEBOUNCE_PERCENTILE or LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW configuration"
+#endif
+
+/* Access to data shared with other contexts */
+#if LWBTN_CFG_USE_ATOMIC
+#if !defined(LWBTN_ATOMIC_LOAD) || !defined(LWBTN_ATOMIC_STORE) || !defined(LWBTN_ATOMIC_FETCH_OR)                     \
+    || !defined(LWBTN_ATOMIC_FETCH_AND)
+#error "LWBTN_ATOMIC_* macros must be defined in the options file for this compiler"
+#endif
+#define LWBTN_SHARED_LOAD(ptr)       LWBTN_ATOMIC_LOAD(ptr)
+#define LWBTN_SHARED_STORE(ptr, val) LWBTN_ATOMIC_STORE((ptr), (val))
+#define LWBTN_SHARED_OR(ptr, val)    LWBTN_ATOMIC_FETCH_OR((ptr), (val))
+#define LWBTN_SHARED_AND(ptr, val)   LWBTN_ATOMIC_FETCH_AND((ptr), (val))
+#else
+#define LWBTN_SHARED_LOAD(ptr)       (*(ptr))
+#define LWBTN_SHARED_STORE(ptr, val) (*(ptr) = (val))
+#define LWBTN_SHARED_OR(ptr, val)    (*(ptr) |= (val))
+#define LWBTN_SHARED_AND(ptr, val)   (*(ptr) &= (val))
+#endif /* LWBTN_CFG_USE_ATOMIC */
+
 #define LWBTN_FLAG_ONPRESS_SENT ((uint16_t)0x0001) /*!< Flag indicates that on-press event has been sent */
 #define LWBTN_FLAG_MANUAL_STATE                                                                                        \
     ((uint16_t)0x0002) /*!< Flag indicates that user wants to manually set button state.
@@ -46,444 +128,3595 @@
     ((uint16_t)0x0004)                      /*!< We are waiting for first inactive state before we continue further */
 #define LWBTN_FLAG_RESET ((uint16_t)0x0008) /*!< Reset called on the button */
 
+#if LWBTN_CFG_USE_COMPACT
+#define LWBTN_FLAG_LAST_STATE ((uint16_t)0x0010) /*!< Last button state, instead of separate variable */
+#define LWBTN_FLAG_LONG_PRESS                                                                                          \
+    ((uint16_t)0x0020) /*!< Press is longer than maximum click time. Marked before 16-bit press time wraps */
+#define LWBTN_BTN_LAST_STATE(btn) (((btn)->flags & LWBTN_FLAG_LAST_STATE) ? 1U : 0U)
+#define LWBTN_BTN_SET_LAST_STATE(btn, state)                                                                           \
+    ((btn)->flags =                                                                                                    \
+         (uint8_t)((state) ? ((btn)->flags | LWBTN_FLAG_LAST_STATE) : ((btn)->flags & ~LWBTN_FLAG_LAST_STATE)))
+
+/* Button times are 16-bit, elapsed time is calculated modulo 2^16 */
+#define LWBTN_BTN_TIME(mstime)          ((lwbtn_btn_time_t)(mstime))
+#define LWBTN_ELAPSED(mstime, btn_time) ((lwbtn_time_t)(lwbtn_btn_time_t)((lwbtn_btn_time_t)(mstime) - (btn_time)))
+
+/* Dynamic parameters are stored in separate array of the group */
+#define LWBTN_BTN_PARAM(lwobj, btn, field, def)                                                                        \
+    ((lwobj)->params != NULL ? (lwobj)->params[(btn) - (lwobj)->btns].field : (def))
+#else
+#define LWBTN_BTN_LAST_STATE(btn)               ((btn)->last_state)
+#define LWBTN_BTN_SET_LAST_STATE(btn, state)    ((btn)->last_state = (state))
+#define LWBTN_BTN_TIME(mstime)                  (mstime)
+#define LWBTN_ELAPSED(mstime, btn_time)         ((lwbtn_time_t)((mstime) - (btn_time)))
+#define LWBTN_BTN_PARAM(lwobj, btn, field, def) ((btn)->field)
+#endif /* LWBTN_CFG_USE_COMPACT */
+
+/* Half of time range, time differences above it are considered negative */
+#define LWBTN_TIME_HALF ((lwbtn_time_t)((lwbtn_time_t)~(lwbtn_time_t)0 >> 1))
+
+/* Events may be sent elsewhere, event function is optional */
+#define LWBTN_EVT_FN_OPTIONAL                                                                                          \
+    (LWBTN_CFG_USE_EVT_QUEUE || LWBTN_CFG_USE_EVT_BATCH || LWBTN_CFG_USE_EVT_INFO || LWBTN_CFG_USE_IDX_CALLBACKS       \
+     || LWBTN_CFG_USE_EVT_MASK)
+
+/* Input states can only be read with get state function */
+#define LWBTN_GET_STATE_FN_REQUIRED                                                                                    \
+    (LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK && !LWBTN_CFG_USE_STATE_MASK                            \
+     && !LWBTN_CFG_USE_IDX_CALLBACKS)
+
+#if LWBTN_CFG_USE_EDGE_QUEUE
+#define LWBTN_FLAG_EDGE       ((uint16_t)0x0040) /*!< Button state is driven by input edges from the queue */
+#define LWBTN_FLAG_EDGE_STATE ((uint16_t)0x0080) /*!< Input state of last edge */
+#define LWBTN_FLAGS_INPUT     (LWBTN_FLAG_EDGE | LWBTN_FLAG_EDGE_STATE)
+#else
+#define LWBTN_FLAGS_INPUT 0
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+
+#if LWBTN_CFG_USE_TRACE
+/* Record tag holds time difference and record code in its lowest 2 bits */
+#define LWBTN_TRACE_CODE_INPUT_0 0x00U /*!< Input changed to inactive state */
+#define LWBTN_TRACE_CODE_INPUT_1 0x01U /*!< Input changed to active state */
+#define LWBTN_TRACE_CODE_EVT     0x02U /*!< Event, followed by button index and event type */
+#define LWBTN_TRACE_CODE_MARK    0x03U /*!< Time mark, without button index */
+#define LWBTN_TRACE_REC_MAX_LEN  16U   /*!< Maximum length of encoded record in bytes */
+#endif                                 /* LWBTN_CFG_USE_TRACE */
+
+#if LWBTN_CFG_USE_TIMING_WHEEL
+#define LWBTN_WHEEL_NONE     ((uint16_t)0xFFFF) /*!< End of slot list, or previous index of first button in slot */
+#define LWBTN_WHEEL_UNLINKED ((uint16_t)0xFFFE) /*!< Previous index of button, that is not linked to any slot */
+#endif                                          /* LWBTN_CFG_USE_TIMING_WHEEL */
+
+#if LWBTN_CFG_USE_DESCRIPTORS
+/* Configuration of the button is read from its constant descriptor */
+#define LWBTN_BTN_DESC(lwobj, btn)                                                                                     \
+    ((lwobj)->descs != NULL ? &(lwobj)->descs[(btn) - (lwobj)->btns] : &lwbtn_desc_default)
+#define LWBTN_BTN_PROFILE_IDX(lwobj, btn) (LWBTN_BTN_DESC((lwobj), (btn))->profile)
+#else
+#define LWBTN_BTN_PROFILE_IDX(lwobj, btn) ((btn)->profile)
+#endif /* LWBTN_CFG_USE_DESCRIPTORS */
+
+/* Features of the button, from its descriptor and its own runtime features */
+#if LWBTN_CFG_USE_DESCRIPTORS && LWBTN_CFG_USE_BTN_FEATURES
+#define LWBTN_BTN_HAS_FEATURE(lwobj, btn, feature)                                                                     \
+    (LWBTN_BTN_DESC((lwobj), (btn))->features & (btn)->features & (feature))
+#elif LWBTN_CFG_USE_DESCRIPTORS
+#define LWBTN_BTN_HAS_FEATURE(lwobj, btn, feature) (LWBTN_BTN_DESC((lwobj), (btn))->features & (feature))
+#elif LWBTN_CFG_USE_BTN_FEATURES
+#define LWBTN_BTN_HAS_FEATURE(lwobj, btn, feature) ((btn)->features & (feature))
+#else
+#define LWBTN_BTN_HAS_FEATURE(lwobj, btn, feature) 1
+#endif /* LWBTN_CFG_USE_DESCRIPTORS && LWBTN_CFG_USE_BTN_FEATURES */
+
+#if LWBTN_CFG_USE_EVT_MASK
+#define LWBTN_BTN_IS_SUBSCRIBED(btn, evt) ((btn)->evt_mask & LWBTN_EVT_MASK(evt))
+#else
+#define LWBTN_BTN_IS_SUBSCRIBED(btn, evt) 1
+#endif /* LWBTN_CFG_USE_EVT_MASK */
+
+/* Click and keep alive work is only done, when button has the feature and is subscribed to its event */
+#if LWBTN_CFG_USE_CLICK
+#define LWBTN_BTN_USES_CLICK(lwobj, btn)                                                                               \
+    (LWBTN_BTN_HAS_FEATURE((lwobj), (btn), LWBTN_BTN_FEATURE_CLICK)                                                    \
+     && LWBTN_BTN_IS_SUBSCRIBED((btn), LWBTN_EVT_ONCLICK))
+#else
+#define LWBTN_BTN_USES_CLICK(lwobj, btn) 0
+#endif /* LWBTN_CFG_USE_CLICK */
+#if LWBTN_CFG_USE_KEEPALIVE
+#define LWBTN_BTN_USES_KEEPALIVE(lwobj, btn)                                                                           \
+    (LWBTN_BTN_HAS_FEATURE((lwobj), (btn), LWBTN_BTN_FEATURE_KEEPALIVE)                                                \
+     && LWBTN_BTN_IS_SUBSCRIBED((btn), LWBTN_EVT_KEEPALIVE))
+#else
+#define LWBTN_BTN_USES_KEEPALIVE(lwobj, btn) 0
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+
+/* Button features can differ, button without click and keep alive can take short processing path */
+#define LWBTN_BTN_FEATURES_RUNTIME                                                                                     \
+    (LWBTN_CFG_USE_DESCRIPTORS || LWBTN_CFG_USE_BTN_FEATURES || LWBTN_CFG_USE_EVT_MASK)
+
+#if LWBTN_CFG_USE_PROFILES
+/* All parameters are read from the profile of the button */
+#define LWBTN_BTN_PROFILE(lwobj, btn) (&(lwobj)->profiles[LWBTN_BTN_PROFILE_IDX((lwobj), (btn))])
+#define LWBTN_TIME_DEBOUNCE_PRESS_GET_CFG(lwobj, btn)                                                                  \
+    ((lwbtn_time_t)LWBTN_BTN_PROFILE(lwobj, btn)->time_debounce)
+#define LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(lwobj, btn)                                                                \
+    ((lwbtn_time_t)LWBTN_BTN_PROFILE(lwobj, btn)->time_debounce_release)
+#define LWBTN_TIME_CLICK_GET_PRESSED_MIN(lwobj, btn)                                                                   \
+    ((lwbtn_time_t)LWBTN_BTN_PROFILE(lwobj, btn)->time_click_pressed_min)
+#define LWBTN_TIME_CLICK_GET_PRESSED_MAX(lwobj, btn)                                                                   \
+    ((lwbtn_time_t)LWBTN_BTN_PROFILE(lwobj, btn)->time_click_pressed_max)
+#define LWBTN_TIME_CLICK_MAX_MULTI(lwobj, btn)                                                                         \
+    ((lwbtn_time_t)LWBTN_BTN_PROFILE(lwobj, btn)->time_click_multi_max)
+#define LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn)                                                                        \
+    ((lwbtn_time_t)LWBTN_BTN_PROFILE(lwobj, btn)->time_keepalive_period)
+#define LWBTN_CLICK_MAX_CONSECUTIVE(lwobj, btn)                                                                        \
+    (LWBTN_BTN_PROFILE(lwobj, btn)->max_consecutive)
+#else /* LWBTN_CFG_USE_PROFILES */
 #if LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC
-#define LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(btn) ((lwbtn_time_t)((btn)->time_debounce))
+#define LWBTN_TIME_DEBOUNCE_PRESS_GET_CFG(lwobj, btn)                                                                  \
+    ((lwbtn_time_t)LWBTN_BTN_PARAM(lwobj, btn, time_debounce, LWBTN_CFG_TIME_DEBOUNCE_PRESS))
 #else
-#define LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(btn) ((lwbtn_time_t)LWBTN_CFG_TIME_DEBOUNCE_PRESS)
+#define LWBTN_TIME_DEBOUNCE_PRESS_GET_CFG(lwobj, btn) ((lwbtn_time_t)LWBTN_CFG_TIME_DEBOUNCE_PRESS)
 #endif /* LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC */
 
 #if LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC
-#define LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(btn) ((lwbtn_time_t)((btn)->time_debounce_release))
+#define LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(lwobj, btn)                                                                \
+    ((lwbtn_time_t)LWBTN_BTN_PARAM(lwobj, btn, time_debounce_release, LWBTN_CFG_TIME_DEBOUNCE_RELEASE))
 #else
-#define LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(btn) ((lwbtn_time_t)LWBTN_CFG_TIME_DEBOUNCE_RELEASE)
+#define LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(lwobj, btn) ((lwbtn_time_t)LWBTN_CFG_TIME_DEBOUNCE_RELEASE)
 #endif /* LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC */
 
 #if LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC
-#define LWBTN_TIME_CLICK_GET_PRESSED_MIN(btn) ((lwbtn_time_t)((btn)->time_click_pressed_min))
+#define LWBTN_TIME_CLICK_GET_PRESSED_MIN(lwobj, btn)                                                                   \
+    ((lwbtn_time_t)LWBTN_BTN_PARAM(lwobj, btn, time_click_pressed_min, LWBTN_CFG_TIME_CLICK_MIN))
 #else
-#define LWBTN_TIME_CLICK_GET_PRESSED_MIN(btn) ((lwbtn_time_t)LWBTN_CFG_TIME_CLICK_MIN)
+#define LWBTN_TIME_CLICK_GET_PRESSED_MIN(lwobj, btn) ((lwbtn_time_t)LWBTN_CFG_TIME_CLICK_MIN)
 #endif /* LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC */
 #if LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC
-#define LWBTN_TIME_CLICK_GET_PRESSED_MAX(btn) ((lwbtn_time_t)((btn)->time_click_pressed_max))
+#define LWBTN_TIME_CLICK_GET_PRESSED_MAX(lwobj, btn)                                                                   \
+    ((lwbtn_time_t)LWBTN_BTN_PARAM(lwobj, btn, time_click_pressed_max, LWBTN_CFG_TIME_CLICK_MAX))
 #else
-#define LWBTN_TIME_CLICK_GET_PRESSED_MAX(btn) ((lwbtn_time_t)LWBTN_CFG_TIME_CLICK_MAX)
+#define LWBTN_TIME_CLICK_GET_PRESSED_MAX(lwobj, btn) ((lwbtn_time_t)LWBTN_CFG_TIME_CLICK_MAX)
 #endif /* LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC */
 #if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC
-#define LWBTN_TIME_CLICK_MAX_MULTI(btn) ((lwbtn_time_t)((btn)->time_click_multi_max))
+#define LWBTN_TIME_CLICK_MAX_MULTI(lwobj, btn)                                                                         \
+    ((lwbtn_time_t)LWBTN_BTN_PARAM(lwobj, btn, time_click_multi_max, LWBTN_CFG_TIME_CLICK_MULTI_MAX))
 #else
-#define LWBTN_TIME_CLICK_MAX_MULTI(btn) ((lwbtn_time_t)LWBTN_CFG_TIME_CLICK_MULTI_MAX)
+#define LWBTN_TIME_CLICK_MAX_MULTI(lwobj, btn) ((lwbtn_time_t)LWBTN_CFG_TIME_CLICK_MULTI_MAX)
 #endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC */
 #if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC
-#define LWBTN_TIME_KEEPALIVE_PERIOD(btn) ((lwbtn_time_t)((btn)->time_keepalive_period))
+#define LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn)                                                                        \
+    ((lwbtn_time_t)LWBTN_BTN_PARAM(lwobj, btn, time_keepalive_period, LWBTN_CFG_TIME_KEEPALIVE_PERIOD))
 #else
-#define LWBTN_TIME_KEEPALIVE_PERIOD(btn) ((lwbtn_time_t)LWBTN_CFG_TIME_KEEPALIVE_PERIOD)
+#define LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn) ((lwbtn_time_t)LWBTN_CFG_TIME_KEEPALIVE_PERIOD)
 #endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC */
 #if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC
-#define LWBTN_CLICK_MAX_CONSECUTIVE(btn) ((btn)->max_consecutive)
+#define LWBTN_CLICK_MAX_CONSECUTIVE(lwobj, btn)                                                                        \
+    LWBTN_BTN_PARAM(lwobj, btn, max_consecutive, LWBTN_CFG_CLICK_MAX_CONSECUTIVE)
 #else
-#define LWBTN_CLICK_MAX_CONSECUTIVE(btn) LWBTN_CFG_CLICK_MAX_CONSECUTIVE
+#define LWBTN_CLICK_MAX_CONSECUTIVE(lwobj, btn) LWBTN_CFG_CLICK_MAX_CONSECUTIVE
 #endif /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC */
+#endif /* LWBTN_CFG_USE_PROFILES */
+
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE
+/* Measured debounce time replaces configured one, after first bounces of the button are measured */
+#define LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn)                                                                  \
+    ((btn)->debounce.time > 0 ? (lwbtn_time_t)(btn)->debounce.time : LWBTN_TIME_DEBOUNCE_PRESS_GET_CFG((lwobj), (btn)))
+#else
+#define LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn) LWBTN_TIME_DEBOUNCE_PRESS_GET_CFG((lwobj), (btn))
+#endif /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE */
+
+/* Press debounce time is only checked, when it can be more than `0` */
+#define LWBTN_TIME_DEBOUNCE_PRESS_USED                                                                                 \
+    (LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_PRESS > 0 || LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE)
+
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE
+/* Steps of bounce percentile estimate in 1/64 ms. Estimate settles where they balance */
+#define LWBTN_ADAPTIVE_STEP_UP   ((uint32_t)LWBTN_CFG_ADAPTIVE_DEBOUNCE_PERCENTILE)
+#define LWBTN_ADAPTIVE_STEP_DOWN ((uint32_t)(100U - LWBTN_CFG_ADAPTIVE_DEBOUNCE_PERCENTILE))
+/* Number of first bounces, whose average is the initial estimate */
+#define LWBTN_ADAPTIVE_SEED_SAMPLES 8U
+#endif /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE */
+
+#if LWBTN_CFG_USE_COMPACT
+/* Time of last keep alive event is calculated from press time and number of keep alive events */
+#define LWBTN_BTN_KEEPALIVE_TIME(lwobj, btn)                                                                           \
+    ((lwbtn_btn_time_t)((btn)->time_change + (btn)->keepalive.cnt * LWBTN_TIME_KEEPALIVE_PERIOD((lwobj), (btn))))
+#else
+#define LWBTN_BTN_KEEPALIVE_TIME(lwobj, btn) ((btn)->keepalive.last_time)
+#endif /* LWBTN_CFG_USE_COMPACT */
+
+/*
+ * Manually set button state.
+ *
+ * With atomic access, manual state marker is stored together with the state,
+ * so that state can be set with single store, without modifying the flags
+ */
+#if LWBTN_CFG_USE_ATOMIC
+#define LWBTN_CURR_STATE_ACTIVE      ((uint8_t)0x01)
+#define LWBTN_CURR_STATE_MANUAL      ((uint8_t)0x02)
+#define LWBTN_BTN_CURR_STATE(btn)    (LWBTN_SHARED_LOAD(&(btn)->curr_state) & LWBTN_CURR_STATE_ACTIVE)
+#define LWBTN_BTN_IS_MANUAL(btn)     (LWBTN_SHARED_LOAD(&(btn)->curr_state) & LWBTN_CURR_STATE_MANUAL)
+#else
+#define LWBTN_BTN_CURR_STATE(btn)    ((btn)->curr_state)
+#define LWBTN_BTN_IS_MANUAL(btn)     ((btn)->flags & LWBTN_FLAG_MANUAL_STATE)
+#endif /* LWBTN_CFG_USE_ATOMIC */
 
 /* Get button state */
 #if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK
 #define LWBTN_BTN_GET_STATE(lwobj, btn) ((lwobj)->get_state_fn((lwobj), (btn)))
 #elif LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL
-#define LWBTN_BTN_GET_STATE(lwobj, btn) ((btn)->curr_state)
+#define LWBTN_BTN_GET_STATE(lwobj, btn) LWBTN_BTN_CURR_STATE(btn)
 #elif LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK_OR_MANUAL
 #define LWBTN_BTN_GET_STATE(lwobj, btn)                                                                                \
-    (((btn)->flags & LWBTN_FLAG_MANUAL_STATE)                                                                          \
-         ? ((btn)->curr_state)                                                                                         \
+    (LWBTN_BTN_IS_MANUAL(btn)                                                                                          \
+         ? LWBTN_BTN_CURR_STATE(btn)                                                                                   \
          : (((lwobj)->get_state_fn != NULL) ? ((lwobj)->get_state_fn((lwobj), (btn))) : 0))
 #endif
 
 /* Default button group instance */
 static lwbtn_t lwbtn_default;
+#if LWBTN_CFG_USE_PROFILES
+/* Profile used when application does not set its own profiles */
+static const lwbtn_profile_t lwbtn_profile_default = LWBTN_PROFILE_DEFAULT;
+#endif /* LWBTN_CFG_USE_PROFILES */
+#if LWBTN_CFG_USE_DESCRIPTORS
+/* Descriptor used when application does not set descriptors of the group */
+static const lwbtn_btn_desc_t lwbtn_desc_default = {.arg = NULL, .features = LWBTN_BTN_FEATURES_ALL};
+#endif /* LWBTN_CFG_USE_DESCRIPTORS */
 #define LWBTN_GET_LWOBJ(in_lwobj) ((in_lwobj) != NULL ? (in_lwobj) : (&lwbtn_default))
 
+#if LWBTN_CFG_USE_TRACE || __DOXYGEN__
+
 /**
- * \brief           Process the button information and state
+ * \brief           Record input state or event of the button to the trace of the group
  * 
- * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
- * \param[in]       btn: Button instance to process
+ * \param[in]       lwobj: LwBTN instance with trace attached
+ * \param[in]       btn: Button instance
+ * \param[in]       type: Record type, member of \ref lwbtn_trace_rec_type_t
+ * \param[in]       val: Input state or event type
  * \param[in]       mstime: Current milliseconds system time
  */
 static void
-prv_process_btn(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
-    uint8_t new_state;
-
-    /* Get button state */
-    new_state = LWBTN_BTN_GET_STATE(lwobj, btn);
+prv_trace_record(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t type, uint8_t val, lwbtn_time_t mstime) {
+    lwbtn_trace_rec_t rec;
 
-    /* 
-     * First state must be "inactive" before
-     * any further button state is being processed.
-     * 
-     * This is to prevent initial detected state on hardware errors,
-     * or when button is kept pressed after the system/lib reset.
-     * 
-     * When user uses manual state set (no callback system),
-     * it is up to user to first call "set state" function and set state to inactive
-     * 
-     * This features is also used for "button reset"
-     */
-    if (!(btn->flags & LWBTN_FLAG_FIRST_INACTIVE_RCVD)) {
-        if (new_state) {
-            return;
-        }
+    rec.time = mstime;
+    rec.btn_idx = (uint16_t)(btn - lwobj->btns);
+    rec.type = type;
+    rec.val = val;
+    lwbtn_trace_write(lwobj->trace, &rec);
+}
 
-        /* Reset all states */
-        btn->last_state = 0;
-        btn->flags = LWBTN_FLAG_FIRST_INACTIVE_RCVD;
-    }
+/**
+ * \brief           Record input state of the button, when it differs from last recorded one
+ * 
+ * \param[in]       lwobj: LwBTN instance with trace attached
+ * \param[in]       btn: Button instance
+ * \param[in]       state: Input state of the button, `1` when active, `0` otherwise
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_trace_input(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t state, lwbtn_time_t mstime) {
+    size_t index = (size_t)(btn - lwobj->btns);
+    lwbtn_word_t mask = (lwbtn_word_t)1 << (index % LWBTN_WORD_BITS);
+    lwbtn_word_t* word = &lwobj->trace_states[index / LWBTN_WORD_BITS];
 
-#if 0
-    /*
-     * When the button is pressed, user can manually
-     * reset the button
-     */
-    if ((btn->flags) & LWBTN_FLAG_RESET) {
-        btn->last_state = 0;             /* Disable the state */
-        btn->flags &= LWBTN_FLAG_RESET; /* Keep reset, delete others */
-        if (new_state) {
-            return;
-        }
-        btn->flags &= ~LWBTN_FLAG_RESET; /* Start over */
+    if (((*word & mask) ? 1 : 0) != state) {
+        *word ^= mask;
+        prv_trace_record(lwobj, btn, LWBTN_TRACE_REC_INPUT, state, mstime);
     }
-#endif
+}
 
-    /* Button state has just changed */
-    if (new_state != btn->last_state) {
-        btn->time_state_change = mstime;
-    }
+#endif /* LWBTN_CFG_USE_TRACE || __DOXYGEN__ */
 
-    /* Button is still pressed */
-    else if (new_state) {
-        /* 
-         * Handle debounce and send on-press event
-         *
-         * This is when we detect valid press
-         */
-        if (!(btn->flags & LWBTN_FLAG_ONPRESS_SENT)) {
-            /*
-             * Run if statement when:
-             *
-             * - Runtime mode is enabled -> user sets its own config for debounce
-             * - Config debounce time for press is more than `0`
-             */
-#if LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_PRESS > 0
-            if ((lwbtn_time_t)(mstime - btn->time_state_change) >= LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(btn))
-#endif /* LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_PRESS> 0 */
-            {
-#if !LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY
-                /*
-                 * Depending on the configuration,
-                 * this part will send on-click event just before the next on-press release,
-                 * if maximum number of consecutive clicks has been reached.
-                 */
-                if (btn->click.cnt > 0 && btn->click.cnt == LWBTN_CLICK_MAX_CONSECUTIVE(btn)) {
-                    lwobj->evt_fn(lwobj, btn, LWBTN_EVT_ONCLICK);
-                    btn->click.cnt = 0;
-                }
-#endif /* !LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY */
+#if LWBTN_CFG_USE_EVT_QUEUE || LWBTN_CFG_USE_EVT_BATCH || LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__
 
-                /* Start with new on-press */
-                btn->flags |= LWBTN_FLAG_ONPRESS_SENT;
-                lwobj->evt_fn(lwobj, btn, LWBTN_EVT_ONPRESS);
+/**
+ * \brief           Fill event record with button data at the time of event
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       evt: Event type
+ * \param[in]       mstime: Current milliseconds system time
+ * \param[out]      rec: Record to fill
+ */
+static void
+prv_evt_rec_fill(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_evt_t evt, lwbtn_time_t mstime, lwbtn_evt_rec_t* rec) {
+    rec->time = mstime;
+    rec->btn_idx = (uint16_t)(btn - lwobj->btns);
+    rec->evt = (uint8_t)evt;
 #if LWBTN_CFG_USE_KEEPALIVE
-                /* Set keep alive time */
-                btn->keepalive.last_time = mstime;
-                btn->keepalive.cnt = 0;
+    rec->keepalive_cnt = btn->keepalive.cnt;
+#else  /* LWBTN_CFG_USE_KEEPALIVE */
+    rec->keepalive_cnt = 0;
 #endif /* LWBTN_CFG_USE_KEEPALIVE */
-
-                btn->time_change = mstime; /* Button state has now changed */
-            }
+#if LWBTN_CFG_USE_CLICK
+    rec->click_cnt = btn->click.cnt;
+#else  /* LWBTN_CFG_USE_CLICK */
+    rec->click_cnt = 0;
+#endif /* LWBTN_CFG_USE_CLICK */
+#if LWBTN_CFG_USE_EVT_INFO
+    /* State change time still holds on-press time, it is updated after on-release event */
+    rec->time_pressed = 0;
+    if (evt == LWBTN_EVT_ONRELEASE
 #if LWBTN_CFG_USE_KEEPALIVE
-        } else {
-            /*
-             * Handle keep alive, but only if on-press event has been sent
-             *
-             * Keep alive is sent when valid press is being detected
-             */
-            while ((lwbtn_time_t)(mstime - btn->keepalive.last_time) >= LWBTN_TIME_KEEPALIVE_PERIOD(btn)) {
-                btn->keepalive.last_time += LWBTN_TIME_KEEPALIVE_PERIOD(btn);
-                ++btn->keepalive.cnt;
-                lwobj->evt_fn(lwobj, btn, LWBTN_EVT_KEEPALIVE);
-            }
+        || evt == LWBTN_EVT_KEEPALIVE
 #endif /* LWBTN_CFG_USE_KEEPALIVE */
-        }
+    ) {
+        rec->time_pressed = LWBTN_ELAPSED(mstime, btn->time_change);
     }
-
-    /* Button is still released */
-    else {
-        /*
-         * We only need to react if on-press event has even been started.
-         *
-         * Do nothing if that was not the case
-         */
-        if (btn->flags & LWBTN_FLAG_ONPRESS_SENT) {
-            /*
-             * Run if statement when:
-             *
-             * - Runtime mode is enabled -> user sets its own config for debounce
-             * - Config debounce time for release is more than `0`
-             */
-#if LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_RELEASE > 0
-            if ((mstime - btn->time_state_change) >= LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(btn))
-#endif /* LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_RELEASE > 0 */
-            {
-                /* Handle on-release event */
-                btn->flags &= ~LWBTN_FLAG_ONPRESS_SENT;
-                lwobj->evt_fn(lwobj, btn, LWBTN_EVT_ONRELEASE);
-
 #if LWBTN_CFG_USE_CLICK
-                /* Check time validity for click event */
-                if ((lwbtn_time_t)(mstime - btn->time_change) >= LWBTN_TIME_CLICK_GET_PRESSED_MIN(btn)
-                    && (lwbtn_time_t)(mstime - btn->time_change) <= LWBTN_TIME_CLICK_GET_PRESSED_MAX(btn)) {
-
-                    /*
-                     * Increase consecutive clicks if max not reached yet
-                     * and if time between two clicks is not long enough
-                     * 
-                     * Otherwise we consider click as fresh one
-                     */
-                    if (btn->click.cnt > 0 && btn->click.cnt < LWBTN_CLICK_MAX_CONSECUTIVE(btn)
-                        && (lwbtn_time_t)(mstime - btn->click.last_time) < LWBTN_TIME_CLICK_MAX_MULTI(btn)) {
-                        ++btn->click.cnt;
-                    } else {
-                        /*
-                         * Take care of any previous clicks if new one doesn't fit anymore in this context.
-                         *
-                         * This can only happen, if onpress started earlier than max consecutive time,
-                         * while onrelease happened later than maximum consecutive time.
-                         * 
-                         * In this case simply report previous state before setting new click.
-                         */
-                        if (btn->click.cnt > 0) {
-                            lwobj->evt_fn(lwobj, btn, LWBTN_EVT_ONCLICK);
-                        }
-                        btn->click.cnt = 1;
-                    }
-                    btn->click.last_time = mstime;
-                } else {
-#if LWBTN_CFG_CLICK_CONSECUTIVE_KEEP_AFTER_SHORT_PRESS
-                    /* If last press was too short, and previous sequence of clicks was positive, send event to user */
-                    if (btn->click.cnt > 0
-                        && (lwbtn_time_t)(mstime - btn->time_change) < LWBTN_TIME_CLICK_GET_PRESSED_MIN(btn)) {
-                        lwobj->evt_fn(lwobj, btn, LWBTN_EVT_ONCLICK);
-                    }
-#endif /* LWBTN_CFG_CLICK_CONSECUTIVE_KEEP_AFTER_SHORT_PRESS */
-                    /*
-                     * There was an on-release event, but timing
-                     * for click event detection is outside allowed window.
-                     * 
-                     * Reset clicks counter -> not valid sequence for click event.
-                     */
-                    btn->click.cnt = 0;
-                }
-
-#if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY
-                /* 
-                 * Depending on the configuration,
-                 * this part will send on-click event immediately after release event,
-                 * if maximum number of consecutive clicks has been reached.
-                 */
-                if (btn->click.cnt > 0 && btn->click.cnt == LWBTN_CLICK_MAX_CONSECUTIVE(btn)) {
-                    lwobj->evt_fn(lwobj, btn, LWBTN_EVT_ONCLICK);
-                    btn->click.cnt = 0;
-                }
-#endif /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY */
+    rec->time_click_gap = btn->click.cnt > 0 ? LWBTN_ELAPSED(mstime, btn->click.last_time) : 0;
+#else  /* LWBTN_CFG_USE_CLICK */
+    rec->time_click_gap = 0;
 #endif /* LWBTN_CFG_USE_CLICK */
+#endif /* LWBTN_CFG_USE_EVT_INFO */
+}
 
-                btn->time_change = mstime; /* Button state has now changed */
-            }
-#if LWBTN_CFG_USE_CLICK
-        } else {
-            /* 
-             * Based on te configuration, this part of the code
-             * will send on-click event after certain timeout.
-             * 
-             * This feature is useful if user prefers multi-click feature
-             * that is reported only after last click event happened,
-             * including number of clicks made by user
-             */
-            if (btn->click.cnt > 0) {
-                if ((lwbtn_time_t)(mstime - btn->click.last_time) >= LWBTN_TIME_CLICK_MAX_MULTI(btn)) {
-                    lwobj->evt_fn(lwobj, btn, LWBTN_EVT_ONCLICK);
-                    btn->click.cnt = 0;
-                }
-            }
-#endif /* LWBTN_CFG_USE_CLICK */
-        }
-    }
+#endif /* LWBTN_CFG_USE_EVT_QUEUE || LWBTN_CFG_USE_EVT_BATCH || LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__ */
 
-    btn->last_state = new_state;
-}
+#if LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__
 
 /**
- * \brief           Initialize button manager
- * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
- * \param[in]       btns: Array of buttons to process
- * \param[in]       btns_cnt: Number of buttons to process
- * \param[in]       get_state_fn: Pointer to function providing button state on demand.
- *                      May be set to `NULL` when \ref LWBTN_CFG_GET_STATE_MODE is set to manual.
- * \param[in]       evt_fn: Button event function callback
- * \return          `1` on success, `0` otherwise
+ * \brief           Write event record to the queue, respecting overflow policy
+ * 
+ * \param[in]       queue: Event queue
+ * \param[in]       rec: Record to write
  */
-uint8_t
-lwbtn_init_ex(lwbtn_t* lwobj, lwbtn_btn_t* btns, uint16_t btns_cnt, lwbtn_get_state_fn get_state_fn,
-              lwbtn_evt_fn evt_fn) {
-    lwobj = LWBTN_GET_LWOBJ(lwobj);
+static void
+prv_evt_queue_put(lwbtn_evt_queue_t* queue, const lwbtn_evt_rec_t* rec) {
+    uint16_t w = queue->w, used = (uint16_t)(w - queue->r);
 
-    if (btns == NULL || btns_cnt == 0 || evt_fn == NULL
-#if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK
-        || get_state_fn == NULL /* Parameter is a must only in callback-only mode */
-#endif                          /* LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK */
+    if (queue->policy == LWBTN_EVT_QUEUE_DROP_OLDEST) {
+        /* Record is written anyway, oldest one is lost */
+        if (used >= queue->size - 1U) {
+            ++queue->dropped;
+        }
+    } else if (used >= queue->size
+#if LWBTN_CFG_USE_KEEPALIVE
+               || (queue->policy == LWBTN_EVT_QUEUE_COALESCE_KEEPALIVE && rec->evt == LWBTN_EVT_KEEPALIVE
+                   && used >= queue->size - queue->size / 4U)
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
     ) {
-        return 0;
+        ++queue->dropped;
+        return;
     }
+    queue->recs[w & (queue->size - 1U)] = *rec;
+    LWBTN_MEMORY_BARRIER(); /* Record must be written before index is updated */
+    queue->w = (uint16_t)(w + 1U);
+}
 
-    LWBTN_MEMSET(lwobj, 0x00, sizeof(*lwobj));
-    lwobj->btns = btns;
-    lwobj->btns_cnt = btns_cnt;
-    lwobj->evt_fn = evt_fn;
-#if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL
-    lwobj->get_state_fn = get_state_fn;
-#else
-    (void)get_state_fn; /* May be unused */
-#endif /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL */
-
-    for (size_t i = 0; i < btns_cnt; ++i) {
-#if LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC
-        btns[i].time_debounce = LWBTN_CFG_TIME_DEBOUNCE_PRESS;
-#endif /* LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC */
-#if LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC
-        btns[i].time_debounce_release = LWBTN_CFG_TIME_DEBOUNCE_RELEASE;
-#endif /* LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC */
-#if LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC
-        btns[i].time_click_pressed_min = LWBTN_CFG_TIME_CLICK_MIN;
-#endif /* LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC */
-#if LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC
-        btns[i].time_click_pressed_max = LWBTN_CFG_TIME_CLICK_MAX;
-#endif /* LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC */
-#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC
-        btns[i].time_click_multi_max = LWBTN_CFG_TIME_CLICK_MULTI_MAX;
-#endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC */
-#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC
-        btns[i].time_keepalive_period = LWBTN_CFG_TIME_KEEPALIVE_PERIOD;
-#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC */
-#if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC
-        btns[i].max_consecutive = LWBTN_CFG_CLICK_MAX_CONSECUTIVE;
-#endif /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC */
-    }
+#endif /* LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__ */
 
-    return 1;
-}
+#if LWBTN_CFG_USE_PARALLEL || __DOXYGEN__
 
 /**
- * \brief           Button processing function, that reads the inputs and makes actions accordingly.
+ * \brief           Store event to the buffer of the shard, that button belongs to
  * 
- * It checks state of all the buttons, linked to the specific LwBTN instance (group).
+ * Button data, that application may read in event function, is stored together with the event
  * 
- * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
- * \param[in]       mstime: Current system time in milliseconds
- * \return          `1` on success, `0` otherwise
+ * \param[in]       lwpar: Parallel processing instance
+ * \param[in]       btn: Button instance
+ * \param[in]       evt: Event type
  */
-uint8_t
-lwbtn_process_ex(lwbtn_t* lwobj, lwbtn_time_t mstime) {
-    lwobj = LWBTN_GET_LWOBJ(lwobj);
+static void
+prv_par_buffer_evt(lwbtn_par_t* lwpar, lwbtn_btn_t* btn, lwbtn_evt_t evt) {
+    size_t index = (size_t)(btn - lwpar->lwobj->btns);
+    lwbtn_par_shard_t* shard = &lwpar->shards[index / lwpar->shard_btns];
+    lwbtn_par_evt_t* rec;
 
-    /* Process all buttons */
-    for (size_t index = 0; index < lwobj->btns_cnt; ++index) {
-        prv_process_btn(lwobj, &lwobj->btns[index], mstime);
-    }
-    return 1;
-}
+    /* Grow the buffer, shard is only accessed by one worker at a time */
+    if (shard->evts_cnt == shard->evts_size) {
+        size_t size = shard->evts_size > 0 ? 2 * shard->evts_size : 16;
+        lwbtn_par_evt_t* evts = realloc(shard->evts, size * sizeof(*evts));
 
-/**
+        if (evts == NULL) {
+            pthread_mutex_lock(&lwpar->mutex);
+            ++lwpar->dropped;
+            pthread_mutex_unlock(&lwpar->mutex);
+            return;
+        }
+        shard->evts = evts;
+        shard->evts_size = size;
+    }
+    rec = &shard->evts[shard->evts_cnt++];
+    rec->btn_idx = (uint16_t)index;
+    rec->evt = (uint8_t)evt;
+    rec->flags = btn->flags;
+#if LWBTN_CFG_USE_KEEPALIVE
+    rec->keepalive_cnt = btn->keepalive.cnt;
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+    rec->click_cnt = btn->click.cnt;
+#endif /* LWBTN_CFG_USE_CLICK */
+}
+
+#endif /* LWBTN_CFG_USE_PARALLEL || __DOXYGEN__ */
+
+/**
+ * \brief           Send event to the application
+ * 
+ * Event is written to the event queue or event batch, when enabled, or sent with event callback function
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       evt: Event type
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_send_evt(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_evt_t evt, lwbtn_time_t mstime) {
+#if LWBTN_CFG_USE_EVT_MASK
+    if (!LWBTN_BTN_IS_SUBSCRIBED(btn, evt)) {
+        return;
+    }
+#endif /* LWBTN_CFG_USE_EVT_MASK */
+#if LWBTN_CFG_USE_TRACE
+    if (lwobj->trace != NULL) {
+        prv_trace_record(lwobj, btn, LWBTN_TRACE_REC_EVT, (uint8_t)evt, mstime);
+    }
+#endif /* LWBTN_CFG_USE_TRACE */
+#if LWBTN_CFG_USE_PARALLEL
+    /* Events are delivered after all workers finish */
+    if (lwobj->par != NULL) {
+        prv_par_buffer_evt(lwobj->par, btn, evt);
+        return;
+    }
+#endif /* LWBTN_CFG_USE_PARALLEL */
+#if LWBTN_CFG_USE_EVT_QUEUE
+    if (lwobj->evt_queue.recs != NULL) {
+        lwbtn_evt_rec_t rec;
+
+        prv_evt_rec_fill(lwobj, btn, evt, mstime, &rec);
+        prv_evt_queue_put(&lwobj->evt_queue, &rec);
+        return;
+    }
+#endif /* LWBTN_CFG_USE_EVT_QUEUE */
+#if LWBTN_CFG_USE_EVT_BATCH
+    /* Events are delivered after processing, event is dropped when batch is full */
+    if (lwobj->evt_batch.recs != NULL && !lwobj->evt_batch.delivering) {
+        if (lwobj->evt_batch.cnt >= lwobj->evt_batch.size) {
+            ++lwobj->evt_batch.dropped;
+            return;
+        }
+        prv_evt_rec_fill(lwobj, btn, evt, mstime, &lwobj->evt_batch.recs[lwobj->evt_batch.cnt++]);
+        return;
+    }
+#endif /* LWBTN_CFG_USE_EVT_BATCH */
+#if LWBTN_CFG_USE_EVT_INFO
+    if (lwobj->evt_info_fn != NULL) {
+        lwbtn_evt_rec_t rec;
+
+        prv_evt_rec_fill(lwobj, btn, evt, mstime, &rec);
+        lwobj->evt_info_fn(lwobj, &rec);
+        return;
+    }
+#endif /* LWBTN_CFG_USE_EVT_INFO */
+#if LWBTN_CFG_USE_IDX_CALLBACKS
+    if (lwobj->evt_idx_fn != NULL) {
+        lwobj->evt_idx_fn(lwobj->user, (uint16_t)(btn - lwobj->btns), evt);
+        return;
+    }
+#endif /* LWBTN_CFG_USE_IDX_CALLBACKS */
+#if LWBTN_CFG_USE_EVT_MASK
+    if (lwobj->evt_fns != NULL) {
+        if (lwobj->evt_fns[evt] != NULL) {
+            lwobj->evt_fns[evt](lwobj, btn, evt);
+        }
+        return;
+    }
+#endif /* LWBTN_CFG_USE_EVT_MASK */
+#if LWBTN_EVT_FN_OPTIONAL
+    if (lwobj->evt_fn == NULL) {
+        return;
+    }
+#endif /* LWBTN_EVT_FN_OPTIONAL */
+    (void)mstime;
+    lwobj->evt_fn(lwobj, btn, evt);
+}
+
+#if LWBTN_CFG_USE_PARALLEL || LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__
+
+/**
+ * \brief           Send deferred event to the application, with button data at the time of event
+ * 
+ * Button data is restored after the event, keeping flag changes made by event function (button reset)
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       evt: Event type
+ * \param[in]       flags: Button flags at the time of event
+ * \param[in]       keepalive_cnt: Keep alive counter at the time of event
+ * \param[in]       click_cnt: Click counter at the time of event
+ * \param[in]       mstime: Time of the event
+ */
+static void
+prv_send_evt_deferred(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_evt_t evt, uint16_t flags, uint16_t keepalive_cnt,
+                      uint8_t click_cnt, lwbtn_time_t mstime) {
+    uint16_t flags_curr = btn->flags;
+#if LWBTN_CFG_USE_KEEPALIVE
+    uint16_t keepalive_cnt_curr = btn->keepalive.cnt;
+    btn->keepalive.cnt = keepalive_cnt;
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+    uint8_t click_cnt_curr = btn->click.cnt;
+    btn->click.cnt = click_cnt;
+#endif /* LWBTN_CFG_USE_CLICK */
+
+    btn->flags = flags;
+#if LWBTN_CFG_USE_TRACE
+    /* Event has already been recorded when it was generated */
+    {
+        lwbtn_trace_t* trace = lwobj->trace;
+
+        lwobj->trace = NULL;
+        prv_send_evt(lwobj, btn, evt, mstime);
+        lwobj->trace = trace;
+    }
+#else
+    prv_send_evt(lwobj, btn, evt, mstime);
+#endif /* LWBTN_CFG_USE_TRACE */
+
+    btn->flags = (uint16_t)(flags_curr ^ (flags ^ btn->flags));
+#if LWBTN_CFG_USE_KEEPALIVE
+    btn->keepalive.cnt = keepalive_cnt_curr;
+#else  /* LWBTN_CFG_USE_KEEPALIVE */
+    (void)keepalive_cnt;
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+    btn->click.cnt = click_cnt_curr;
+#else  /* LWBTN_CFG_USE_CLICK */
+    (void)click_cnt;
+#endif /* LWBTN_CFG_USE_CLICK */
+}
+
+#endif /* LWBTN_CFG_USE_PARALLEL || LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__
+
+/**
+ * \brief           Deliver collected events to the application and empty the batch
+ * 
+ * Events, generated while batch is delivered, are sent directly to event function
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ */
+static void
+prv_evt_batch_deliver(lwbtn_t* lwobj) {
+    lwbtn_evt_batch_t* batch = &lwobj->evt_batch;
+
+    if (batch->cnt == 0 || batch->delivering) {
+        return;
+    }
+    batch->delivering = 1;
+    if (batch->evt_batch_fn != NULL) {
+        batch->evt_batch_fn(lwobj, batch->recs, batch->cnt);
+    } else {
+        for (size_t i = 0; i < batch->cnt; ++i) {
+            const lwbtn_evt_rec_t* rec = &batch->recs[i];
+
+            lwbtn_btn_t* btn = &lwobj->btns[rec->btn_idx];
+
+#if LWBTN_CFG_USE_EVT_INFO
+            /* Record already carries button data of the event */
+            if (lwobj->evt_info_fn != NULL) {
+                lwobj->evt_info_fn(lwobj, rec);
+                continue;
+            }
+#endif /* LWBTN_CFG_USE_EVT_INFO */
+            prv_send_evt_deferred(lwobj, btn, (lwbtn_evt_t)rec->evt, btn->flags, rec->keepalive_cnt, rec->click_cnt,
+                                  rec->time);
+        }
+    }
+    batch->cnt = 0;
+    batch->delivering = 0;
+}
+
+#endif /* LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__ */
+
+/**
+ * \brief           Handle valid (debounced) press of the button
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance to process
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_btn_onpress(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
+#if LWBTN_CFG_USE_CLICK && !LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY
+    /*
+     * Depending on the configuration,
+     * this part will send on-click event just before the next on-press release,
+     * if maximum number of consecutive clicks has been reached.
+     */
+    if (btn->click.cnt > 0 && btn->click.cnt == LWBTN_CLICK_MAX_CONSECUTIVE(lwobj, btn)) {
+        prv_send_evt(lwobj, btn, LWBTN_EVT_ONCLICK, mstime);
+        btn->click.cnt = 0;
+    }
+#endif /* LWBTN_CFG_USE_CLICK && !LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY */
+
+    /* Start with new on-press */
+    btn->flags |= LWBTN_FLAG_ONPRESS_SENT;
+#if LWBTN_CFG_USE_COMPACT
+    btn->flags &= ~LWBTN_FLAG_LONG_PRESS;
+#endif /* LWBTN_CFG_USE_COMPACT */
+    prv_send_evt(lwobj, btn, LWBTN_EVT_ONPRESS, mstime);
+#if LWBTN_CFG_USE_KEEPALIVE
+    /* Set keep alive time */
+#if !LWBTN_CFG_USE_COMPACT
+    btn->keepalive.last_time = mstime;
+#endif /* !LWBTN_CFG_USE_COMPACT */
+    btn->keepalive.cnt = 0;
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+
+    btn->time_change = LWBTN_BTN_TIME(mstime); /* Button state has now changed */
+}
+
+#if LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__
+
+/**
+ * \brief           Handle keep alive events of the button, that has on-press event already sent
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance to process
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_btn_keepalive(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
+#if LWBTN_CFG_KEEPALIVE_COALESCE
+    lwbtn_time_t period = LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn);
+    lwbtn_time_t periods = LWBTN_ELAPSED(mstime, LWBTN_BTN_KEEPALIVE_TIME(lwobj, btn)) / period;
+
+    /* All missed periods are reported with single event, in constant time */
+    if (periods > 0) {
+#if !LWBTN_CFG_USE_COMPACT
+        btn->keepalive.last_time += periods * period;
+#endif /* !LWBTN_CFG_USE_COMPACT */
+        btn->keepalive.cnt += (uint16_t)periods;
+        btn->keepalive.evt_periods = (uint16_t)periods;
+        prv_send_evt(lwobj, btn, LWBTN_EVT_KEEPALIVE, mstime);
+    }
+#else
+    /*
+     * Handle keep alive, but only if on-press event has been sent
+     *
+     * Keep alive is sent when valid press is being detected
+     */
+    while (LWBTN_ELAPSED(mstime, LWBTN_BTN_KEEPALIVE_TIME(lwobj, btn)) >= LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn)) {
+#if !LWBTN_CFG_USE_COMPACT
+        btn->keepalive.last_time += LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn);
+#endif /* !LWBTN_CFG_USE_COMPACT */
+        ++btn->keepalive.cnt;
+        prv_send_evt(lwobj, btn, LWBTN_EVT_KEEPALIVE, mstime);
+    }
+#endif /* LWBTN_CFG_KEEPALIVE_COALESCE */
+}
+
+#endif /* LWBTN_CFG_USE_KEEPALIVE || __DOXYGEN__ */
+
+/**
+ * \brief           Handle valid (debounced) release of the button
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance to process
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_btn_onrelease(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
+#if LWBTN_CFG_USE_CLICK
+    lwbtn_time_t pressed_time = LWBTN_ELAPSED(mstime, btn->time_change);
+
+#if LWBTN_CFG_USE_COMPACT
+    /* Long press time may have already wrapped */
+    if (btn->flags & LWBTN_FLAG_LONG_PRESS) {
+        pressed_time = ~(lwbtn_time_t)0;
+    }
+#endif /* LWBTN_CFG_USE_COMPACT */
+#if LWBTN_BTN_FEATURES_RUNTIME
+    /* Press never fits click window when button does not detect clicks */
+    if (!LWBTN_BTN_USES_CLICK(lwobj, btn)) {
+        pressed_time = ~(lwbtn_time_t)0;
+    }
+#endif /* LWBTN_BTN_FEATURES_RUNTIME */
+#endif /* LWBTN_CFG_USE_CLICK */
+
+    /* Handle on-release event */
+    btn->flags &= ~LWBTN_FLAG_ONPRESS_SENT;
+    prv_send_evt(lwobj, btn, LWBTN_EVT_ONRELEASE, mstime);
+
+#if LWBTN_CFG_USE_CLICK
+    /* Check time validity for click event */
+    if (pressed_time >= LWBTN_TIME_CLICK_GET_PRESSED_MIN(lwobj, btn)
+        && pressed_time <= LWBTN_TIME_CLICK_GET_PRESSED_MAX(lwobj, btn)) {
+
+        /*
+         * Increase consecutive clicks if max not reached yet
+         * and if time between two clicks is not long enough
+         * 
+         * Otherwise we consider click as fresh one
+         */
+        if (btn->click.cnt > 0 && btn->click.cnt < LWBTN_CLICK_MAX_CONSECUTIVE(lwobj, btn)
+            && LWBTN_ELAPSED(mstime, btn->click.last_time) < LWBTN_TIME_CLICK_MAX_MULTI(lwobj, btn)) {
+            ++btn->click.cnt;
+        } else {
+            /*
+             * Take care of any previous clicks if new one doesn't fit anymore in this context.
+             *
+             * This can only happen, if onpress started earlier than max consecutive time,
+             * while onrelease happened later than maximum consecutive time.
+             * 
+             * In this case simply report previous state before setting new click.
+             */
+            if (btn->click.cnt > 0) {
+                prv_send_evt(lwobj, btn, LWBTN_EVT_ONCLICK, mstime);
+            }
+            btn->click.cnt = 1;
+        }
+        btn->click.last_time = LWBTN_BTN_TIME(mstime);
+    } else {
+#if LWBTN_CFG_CLICK_CONSECUTIVE_KEEP_AFTER_SHORT_PRESS
+        /* If last press was too short, and previous sequence of clicks was positive, send event to user */
+        if (btn->click.cnt > 0 && pressed_time < LWBTN_TIME_CLICK_GET_PRESSED_MIN(lwobj, btn)) {
+            prv_send_evt(lwobj, btn, LWBTN_EVT_ONCLICK, mstime);
+        }
+#endif /* LWBTN_CFG_CLICK_CONSECUTIVE_KEEP_AFTER_SHORT_PRESS */
+        /*
+         * There was an on-release event, but timing
+         * for click event detection is outside allowed window.
+         * 
+         * Reset clicks counter -> not valid sequence for click event.
+         */
+        btn->click.cnt = 0;
+    }
+
+#if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY
+    /* 
+     * Depending on the configuration,
+     * this part will send on-click event immediately after release event,
+     * if maximum number of consecutive clicks has been reached.
+     */
+    if (btn->click.cnt > 0 && btn->click.cnt == LWBTN_CLICK_MAX_CONSECUTIVE(lwobj, btn)) {
+        prv_send_evt(lwobj, btn, LWBTN_EVT_ONCLICK, mstime);
+        btn->click.cnt = 0;
+    }
+#endif /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_SEND_IMMEDIATELY */
+#endif /* LWBTN_CFG_USE_CLICK */
+
+    btn->time_change = LWBTN_BTN_TIME(mstime); /* Button state has now changed */
+}
+
+#if LWBTN_CFG_USE_CLICK || __DOXYGEN__
+
+/**
+ * \brief           Send on-click event after multi-click timeout, for released button
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance to process
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_btn_click_timeout(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
+    /* 
+     * Based on te configuration, this part of the code
+     * will send on-click event after certain timeout.
+     * 
+     * This feature is useful if user prefers multi-click feature
+     * that is reported only after last click event happened,
+     * including number of clicks made by user
+     */
+    if (btn->click.cnt > 0) {
+        if (LWBTN_ELAPSED(mstime, btn->click.last_time) >= LWBTN_TIME_CLICK_MAX_MULTI(lwobj, btn)) {
+            prv_send_evt(lwobj, btn, LWBTN_EVT_ONCLICK, mstime);
+            btn->click.cnt = 0;
+        }
+    }
+}
+
+#endif /* LWBTN_CFG_USE_CLICK || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_BITSLICE || LWBTN_CFG_USE_ACTIVE_SET
+
+/**
+ * \brief           Get index of least significant bit set in the word
+ * \param[in]       word: Word to check. Must not be `0`
+ * \return          Bit index
+ */
+static uint8_t
+prv_ctz(lwbtn_word_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)(sizeof(word) > sizeof(unsigned long) ? __builtin_ctzll(word) : __builtin_ctzl(word));
+#else
+    uint8_t bit = 0;
+    while (!(word & 1U)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif /* defined(__GNUC__) || defined(__clang__) */
+}
+
+#endif /* LWBTN_CFG_USE_BITSLICE || LWBTN_CFG_USE_ACTIVE_SET */
+
+/**
+ * \brief           Get current input state of the button
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance from the group
+ * \return          `1` when button is considered `active`, `0` otherwise
+ */
+static uint8_t
+prv_btn_get_state(lwbtn_t* lwobj, lwbtn_btn_t* btn) {
+#if LWBTN_CFG_USE_TRACE
+    /* Take state from replayed trace */
+    if (lwobj->replay_states != NULL) {
+        size_t index = (size_t)(btn - lwobj->btns);
+        return (uint8_t)((lwobj->replay_states[index / LWBTN_WORD_BITS] >> (index % LWBTN_WORD_BITS)) & 1U);
+    }
+#endif /* LWBTN_CFG_USE_TRACE */
+#if LWBTN_CFG_USE_EDGE_QUEUE
+    /* Take state from last edge */
+    if (btn->flags & LWBTN_FLAG_EDGE) {
+        return (btn->flags & LWBTN_FLAG_EDGE_STATE) ? 1 : 0;
+    }
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+#if LWBTN_CFG_USE_STATE_MASK
+    /* Take state from group mask */
+    if (lwobj->state_mask != NULL) {
+        size_t index = (size_t)(btn - lwobj->btns);
+        return (uint8_t)((lwobj->state_mask[index / LWBTN_WORD_BITS] >> (index % LWBTN_WORD_BITS)) & 1U);
+    }
+#endif /* LWBTN_CFG_USE_STATE_MASK */
+#if LWBTN_CFG_USE_IDX_CALLBACKS && LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL
+    /* Index function takes precedence over get state function */
+    if (lwobj->get_state_idx_fn != NULL
+#if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK_OR_MANUAL
+        && !LWBTN_BTN_IS_MANUAL(btn)
+#endif /* LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK_OR_MANUAL */
+    ) {
+        return lwobj->get_state_idx_fn(lwobj->user, (uint16_t)(btn - lwobj->btns));
+    }
+#endif /* LWBTN_CFG_USE_IDX_CALLBACKS && LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL */
+    (void)lwobj; /* May be unused in manual mode */
+    return LWBTN_BTN_GET_STATE(lwobj, btn);
+}
+
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__
+
+/**
+ * \brief           Measure bounce duration of the button and update its debounce time
+ * 
+ * Bounce starts with input change and ends with first stable input, that lasts for current debounce time.
+ * Only input changes within one debounce attempt are measured, separate presses and releases are separate bounces.
+ * Initial estimate is the average of first bounces, it is then moved with fixed steps to the percentile,
+ * up step is the percentile and down step its complement.
+ * It is called before input state of the button is processed.
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       new_state: Input state of the button, `1` when active, `0` otherwise
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_adaptive_debounce_update(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t new_state, lwbtn_time_t mstime) {
+    lwbtn_time_t bounce;
+    uint32_t sample, est, time;
+
+    if (new_state != LWBTN_BTN_LAST_STATE(btn)) {
+        if (!btn->debounce.measuring) {
+            btn->debounce.start = LWBTN_BTN_TIME(mstime);
+            btn->debounce.measuring = 1;
+        }
+        return;
+    }
+    (void)lwobj; /* May be unused with fixed timings */
+    if (!btn->debounce.measuring
+        || LWBTN_ELAPSED(mstime, btn->time_state_change) < LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn)) {
+        return;
+    }
+    btn->debounce.measuring = 0;
+
+    /* Time from first to last input change */
+    bounce = LWBTN_ELAPSED(btn->time_state_change, btn->debounce.start);
+    if (bounce > (lwbtn_time_t)LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW) {
+        bounce = LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW;
+    }
+
+    /* Sum of first bounces, in ms, until there is enough of them for the initial estimate */
+    if (btn->debounce.time == 0) {
+        btn->debounce.bounce += (uint16_t)bounce;
+        if (++btn->debounce.samples < LWBTN_ADAPTIVE_SEED_SAMPLES) {
+            return;
+        }
+    }
+
+    /* Estimate in 1/64 ms */
+    sample = (uint32_t)bounce * 64U;
+    est = btn->debounce.bounce;
+    if (btn->debounce.time == 0) {
+        est = est * 64U / LWBTN_ADAPTIVE_SEED_SAMPLES;
+    } else if (sample > est) {
+        est += LWBTN_ADAPTIVE_STEP_UP;
+        if (est > LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW * 64U) {
+            est = LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW * 64U;
+        }
+    } else if (sample < est) {
+        est = est > LWBTN_ADAPTIVE_STEP_DOWN ? est - LWBTN_ADAPTIVE_STEP_DOWN : 0;
+    }
+    btn->debounce.bounce = (uint16_t)est;
+
+    /* Debounce time is just above the estimate, at least 1 ms */
+    time = (est + 63U) / 64U + LWBTN_CFG_ADAPTIVE_DEBOUNCE_MARGIN;
+    if (time > LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW) {
+        time = LWBTN_CFG_ADAPTIVE_DEBOUNCE_WINDOW;
+    }
+    btn->debounce.time = (uint8_t)(time > 0 ? time : 1);
+}
+
+#endif /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__ */
+
+#if LWBTN_BTN_FEATURES_RUNTIME || __DOXYGEN__
+
+/**
+ * \brief           Process the button without click and keep alive features, with known input state
+ * 
+ * Button only debounces its input and sends on-press and on-release events.
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance to process
+ * \param[in]       new_state: Input state of the button, `1` when active, `0` otherwise
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_process_btn_state_basic(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t new_state, lwbtn_time_t mstime) {
+    if (new_state != LWBTN_BTN_LAST_STATE(btn)) {
+        btn->time_state_change = LWBTN_BTN_TIME(mstime);
+    } else if (new_state != ((btn->flags & LWBTN_FLAG_ONPRESS_SENT) ? 1 : 0)) {
+        /* Stable state differs from last sent event */
+        if (LWBTN_ELAPSED(mstime, btn->time_state_change)
+            >= (new_state ? LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn)
+                          : LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(lwobj, btn))) {
+            btn->flags ^= LWBTN_FLAG_ONPRESS_SENT;
+#if LWBTN_CFG_USE_KEEPALIVE
+            btn->keepalive.cnt = 0;
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+            prv_send_evt(lwobj, btn, new_state ? LWBTN_EVT_ONPRESS : LWBTN_EVT_ONRELEASE, mstime);
+            btn->time_change = LWBTN_BTN_TIME(mstime);
+        }
+    }
+    LWBTN_BTN_SET_LAST_STATE(btn, new_state);
+}
+
+#endif /* LWBTN_BTN_FEATURES_RUNTIME || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_MASK || LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__
+
+/**
+ * \brief           Drop pending work of features, that button does not use anymore
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ */
+static void
+prv_btn_features_changed(lwbtn_t* lwobj, lwbtn_btn_t* btn) {
+#if LWBTN_CFG_USE_CLICK
+    /* Pending click sequence is never reported */
+    if (!LWBTN_BTN_USES_CLICK(lwobj, btn)) {
+        btn->click.cnt = 0;
+    }
+#endif /* LWBTN_CFG_USE_CLICK */
+    (void)lwobj;
+    (void)btn;
+}
+
+#endif /* LWBTN_CFG_USE_EVT_MASK || LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__ */
+
+/**
+ * \brief           Process the button with known input state
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance to process
+ * \param[in]       new_state: Input state of the button, `1` when active, `0` otherwise
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_process_btn_state(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t new_state, lwbtn_time_t mstime) {
+    /* 
+     * First state must be "inactive" before
+     * any further button state is being processed.
+     * 
+     * This is to prevent initial detected state on hardware errors,
+     * or when button is kept pressed after the system/lib reset.
+     * 
+     * When user uses manual state set (no callback system),
+     * it is up to user to first call "set state" function and set state to inactive
+     * 
+     * This features is also used for "button reset"
+     */
+    if (!(btn->flags & LWBTN_FLAG_FIRST_INACTIVE_RCVD)) {
+        if (new_state) {
+            /* Active input is ignored, only next input edge can bring inactive state */
+            LWBTN_BTN_SET_LAST_STATE(btn, 1);
+            return;
+        }
+
+        /* Reset all states, except input source */
+        btn->flags = (btn->flags & LWBTN_FLAGS_INPUT) | LWBTN_FLAG_FIRST_INACTIVE_RCVD;
+        LWBTN_BTN_SET_LAST_STATE(btn, 0);
+    }
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE
+    prv_adaptive_debounce_update(lwobj, btn, new_state, mstime);
+#endif /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE */
+
+#if 0
+    /*
+     * When the button is pressed, user can manually
+     * reset the button
+     */
+    if ((btn->flags) & LWBTN_FLAG_RESET) {
+        btn->last_state = 0;             /* Disable the state */
+        btn->flags &= LWBTN_FLAG_RESET; /* Keep reset, delete others */
+        if (new_state) {
+            return;
+        }
+        btn->flags &= ~LWBTN_FLAG_RESET; /* Start over */
+    }
+#endif
+
+#if LWBTN_BTN_FEATURES_RUNTIME
+    /* Button with press and release events only takes short path */
+    if (!LWBTN_BTN_USES_CLICK(lwobj, btn) && !LWBTN_BTN_USES_KEEPALIVE(lwobj, btn)) {
+        prv_process_btn_state_basic(lwobj, btn, new_state, mstime);
+        return;
+    }
+#endif /* LWBTN_BTN_FEATURES_RUNTIME */
+
+    /* Button state has just changed */
+    if (new_state != LWBTN_BTN_LAST_STATE(btn)) {
+        btn->time_state_change = LWBTN_BTN_TIME(mstime);
+    }
+
+    /* Button is still pressed */
+    else if (new_state) {
+        /* 
+         * Handle debounce and send on-press event
+         *
+         * This is when we detect valid press
+         */
+        if (!(btn->flags & LWBTN_FLAG_ONPRESS_SENT)) {
+            /*
+             * Run if statement when:
+             *
+             * - Runtime mode is enabled -> user sets its own config for debounce
+             * - Config debounce time for press is more than `0`
+             */
+#if LWBTN_TIME_DEBOUNCE_PRESS_USED
+            if (LWBTN_ELAPSED(mstime, btn->time_state_change) >= LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn))
+#endif /* LWBTN_TIME_DEBOUNCE_PRESS_USED */
+            {
+                prv_btn_onpress(lwobj, btn, mstime);
+            }
+#if LWBTN_CFG_USE_KEEPALIVE || (LWBTN_CFG_USE_COMPACT && LWBTN_CFG_USE_CLICK)
+        } else {
+#if LWBTN_CFG_USE_COMPACT && LWBTN_CFG_USE_CLICK
+            /* Mark long press, before 16-bit press time wraps */
+            if (LWBTN_ELAPSED(mstime, btn->time_change) > LWBTN_TIME_CLICK_GET_PRESSED_MAX(lwobj, btn)) {
+                btn->flags |= LWBTN_FLAG_LONG_PRESS;
+            }
+#endif /* LWBTN_CFG_USE_COMPACT && LWBTN_CFG_USE_CLICK */
+#if LWBTN_CFG_USE_KEEPALIVE
+            if (LWBTN_BTN_USES_KEEPALIVE(lwobj, btn)) {
+                prv_btn_keepalive(lwobj, btn, mstime);
+            }
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#endif /* LWBTN_CFG_USE_KEEPALIVE || (LWBTN_CFG_USE_COMPACT && LWBTN_CFG_USE_CLICK) */
+        }
+    }
+
+    /* Button is still released */
+    else {
+        /*
+         * We only need to react if on-press event has even been started.
+         *
+         * Do nothing if that was not the case
+         */
+        if (btn->flags & LWBTN_FLAG_ONPRESS_SENT) {
+            /*
+             * Run if statement when:
+             *
+             * - Runtime mode is enabled -> user sets its own config for debounce
+             * - Config debounce time for release is more than `0`
+             */
+#if LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_RELEASE > 0
+            if (LWBTN_ELAPSED(mstime, btn->time_state_change) >= LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(lwobj, btn))
+#endif /* LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC || LWBTN_CFG_TIME_DEBOUNCE_RELEASE > 0 */
+            {
+                prv_btn_onrelease(lwobj, btn, mstime);
+            }
+#if LWBTN_CFG_USE_CLICK
+        } else {
+            prv_btn_click_timeout(lwobj, btn, mstime);
+#endif /* LWBTN_CFG_USE_CLICK */
+        }
+    }
+
+    LWBTN_BTN_SET_LAST_STATE(btn, new_state);
+}
+
+/**
+ * \brief           Get remaining time until period has elapsed
+ * \param[in]       elapsed: Already elapsed time in milliseconds
+ * \param[in]       period: Period in milliseconds
+ * \return          Remaining time in milliseconds, `0` if period has already elapsed
+ */
+static lwbtn_time_t
+prv_time_remaining(lwbtn_time_t elapsed, lwbtn_time_t period) {
+    return elapsed >= period ? 0 : (lwbtn_time_t)(period - elapsed);
+}
+
+/**
+ * \brief           Get remaining time until next event timeout of the button
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       mstime: Current time in milliseconds
+ * \param[out]      remaining: Remaining time in milliseconds, valid when function returns `1`
+ * \return          `1` when button has pending timeout, `0` if it waits for next input edge
+ */
+static uint8_t
+prv_btn_get_remaining_timeouts(const lwbtn_t* lwobj, const lwbtn_btn_t* btn, lwbtn_time_t mstime,
+                               lwbtn_time_t* remaining) {
+    (void)lwobj;
+    /*
+     * Button is waiting for first inactive state.
+     * Active input has been seen, only input edge can change it.
+     * Otherwise, as after reset of released button, next processing receives inactive state.
+     */
+    if (!(btn->flags & LWBTN_FLAG_FIRST_INACTIVE_RCVD)) {
+        if (LWBTN_BTN_LAST_STATE(btn)) {
+            return 0;
+        }
+        *remaining = 0;
+        return 1;
+    }
+#if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK
+    /* Manually set state that has not been processed yet */
+    if (LWBTN_BTN_IS_MANUAL(btn) && LWBTN_BTN_CURR_STATE(btn) != LWBTN_BTN_LAST_STATE(btn)) {
+        *remaining = 0;
+        return 1;
+    }
+#endif /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK */
+
+    if (LWBTN_BTN_LAST_STATE(btn)) {
+        if (!(btn->flags & LWBTN_FLAG_ONPRESS_SENT)) {
+            /* Press debounce */
+            *remaining = prv_time_remaining(LWBTN_ELAPSED(mstime, btn->time_state_change),
+                                            LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn));
+            return 1;
+        }
+#if LWBTN_CFG_USE_KEEPALIVE
+        /* Next keep alive event */
+        if (LWBTN_BTN_USES_KEEPALIVE(lwobj, btn)) {
+            *remaining = prv_time_remaining(LWBTN_ELAPSED(mstime, LWBTN_BTN_KEEPALIVE_TIME(lwobj, btn)),
+                                            LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn));
+            return 1;
+        }
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_COMPACT && LWBTN_CFG_USE_CLICK
+        /* Long press must be marked before 16-bit press time wraps */
+        if (!(btn->flags & LWBTN_FLAG_LONG_PRESS) && LWBTN_BTN_USES_CLICK(lwobj, btn)) {
+            *remaining = prv_time_remaining(LWBTN_ELAPSED(mstime, btn->time_change),
+                                            LWBTN_TIME_CLICK_GET_PRESSED_MAX(lwobj, btn) + 1U);
+            return 1;
+        }
+#endif /* LWBTN_CFG_USE_COMPACT && LWBTN_CFG_USE_CLICK */
+    } else {
+        if (btn->flags & LWBTN_FLAG_ONPRESS_SENT) {
+            /* Release debounce */
+            *remaining = prv_time_remaining(LWBTN_ELAPSED(mstime, btn->time_state_change),
+                                            LWBTN_TIME_DEBOUNCE_RELEASE_GET_MIN(lwobj, btn));
+            return 1;
+        }
+#if LWBTN_CFG_USE_CLICK
+        /* Multi-click timeout */
+        if (btn->click.cnt > 0) {
+            *remaining = prv_time_remaining(LWBTN_ELAPSED(mstime, btn->click.last_time),
+                                            LWBTN_TIME_CLICK_MAX_MULTI(lwobj, btn));
+            return 1;
+        }
+#endif /* LWBTN_CFG_USE_CLICK */
+    }
+    return 0;
+}
+
+/**
+ * \brief           Get remaining time until processing of the button can change anything
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       mstime: Current time in milliseconds
+ * \param[out]      remaining: Remaining time in milliseconds, valid when function returns `1`
+ * \return          `1` when button has pending timeout, `0` if it waits for next input edge
+ */
+static uint8_t
+prv_btn_get_remaining(const lwbtn_t* lwobj, const lwbtn_btn_t* btn, lwbtn_time_t mstime, lwbtn_time_t* remaining) {
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE
+    /* Bounce measurement ends after stable input */
+    if ((btn->flags & LWBTN_FLAG_FIRST_INACTIVE_RCVD) && btn->debounce.measuring) {
+        lwbtn_time_t stable = prv_time_remaining(LWBTN_ELAPSED(mstime, btn->time_state_change),
+                                                 LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn));
+
+        if (!prv_btn_get_remaining_timeouts(lwobj, btn, mstime, remaining) || stable < *remaining) {
+            *remaining = stable;
+        }
+        return 1;
+    }
+#endif /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE */
+    return prv_btn_get_remaining_timeouts(lwobj, btn, mstime, remaining);
+}
+
+#if LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Get later of two times, that are not after reference time
+ * \param[in]       time: Reference time
+ * \param[in]       now: Current candidate, not after reference time
+ * \param[in]       btn_time: Time stored in the button
+ * \return          Button time, when it is between candidate and reference time, candidate otherwise
+ */
+static lwbtn_time_t
+prv_time_latest(lwbtn_time_t time, lwbtn_time_t now, lwbtn_btn_time_t btn_time) {
+    lwbtn_time_t since = LWBTN_ELAPSED(time, btn_time);
+
+    return since < (lwbtn_time_t)(time - now) ? (lwbtn_time_t)(time - since) : now;
+}
+
+/**
+ * \brief           Process timeouts of edge driven button, that expire until specific time
+ *
+ * Input state is stable since last edge, timeouts are therefore processed at their exact time,
+ * instead of at the time of processing call.
+ *
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       time: Time to process the timeouts until, including
+ */
+static void
+prv_edge_process_timeouts(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t time) {
+    lwbtn_time_t now = lwobj->edge_queue.time_last, remaining;
+    uint8_t processed = 0;
+
+    /* Button has been processed at least at the latest of its times */
+    now = prv_time_latest(time, now, btn->time_state_change);
+    now = prv_time_latest(time, now, btn->time_change);
+#if LWBTN_CFG_USE_KEEPALIVE
+    now = prv_time_latest(time, now, LWBTN_BTN_KEEPALIVE_TIME(lwobj, btn));
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+    now = prv_time_latest(time, now, btn->click.last_time);
+#endif /* LWBTN_CFG_USE_CLICK */
+
+    while (prv_btn_get_remaining(lwobj, btn, now, &remaining) && remaining <= (lwbtn_time_t)(time - now)) {
+        /* Timeout that processing cannot clear, such as pending manual state */
+        if (remaining == 0 && processed) {
+            break;
+        }
+        processed = remaining == 0;
+        now = (lwbtn_time_t)(now + remaining);
+        prv_process_btn_state(lwobj, btn, LWBTN_BTN_LAST_STATE(btn), now);
+    }
+}
+
+/**
+ * \brief           Replay one input edge of the button
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance
+ * \param[in]       state: New input state
+ * \param[in]       time: Time of the edge
+ */
+static void
+prv_edge_replay_btn(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t state, lwbtn_time_t time) {
+    /* Repeated edge does not change the input */
+    if ((btn->flags & LWBTN_FLAG_EDGE) && ((btn->flags & LWBTN_FLAG_EDGE_STATE) ? 1 : 0) == state) {
+        return;
+    }
+    btn->flags |= LWBTN_FLAG_EDGE;
+    if (state) {
+        btn->flags |= LWBTN_FLAG_EDGE_STATE;
+    } else {
+        btn->flags &= ~LWBTN_FLAG_EDGE_STATE;
+    }
+    if (state == LWBTN_BTN_LAST_STATE(btn)) {
+        return;
+    }
+
+    /* Previous state has been stable until the edge */
+    prv_edge_process_timeouts(lwobj, btn, time);
+#if LWBTN_CFG_USE_TRACE
+    if (lwobj->trace != NULL) {
+        prv_trace_input(lwobj, btn, state, time);
+    }
+#endif /* LWBTN_CFG_USE_TRACE */
+    prv_process_btn_state(lwobj, btn, state, time);
+
+#if LWBTN_CFG_USE_ACTIVE_SET
+    /* Button is processed again at current time */
+    if (lwobj->active != NULL) {
+        size_t index = (size_t)(btn - lwobj->btns);
+        LWBTN_SHARED_OR(&lwobj->active[index / LWBTN_WORD_BITS], (lwbtn_word_t)1 << (index % LWBTN_WORD_BITS));
+    }
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+}
+
+/**
+ * \brief           Replay queued input edges, that happened before current time
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_edge_queue_replay(lwbtn_t* lwobj, lwbtn_time_t mstime) {
+    lwbtn_edge_queue_t* queue = &lwobj->edge_queue;
+    lwbtn_time_t window = (lwbtn_time_t)(mstime - queue->time_last);
+    uint16_t r = queue->r;
+
+    while (r != queue->w) {
+        lwbtn_edge_t edge;
+        lwbtn_time_t offset;
+
+        LWBTN_MEMORY_BARRIER(); /* Index must be read before the record */
+        edge = queue->edges[r & (queue->size - 1U)];
+        offset = (lwbtn_time_t)(edge.time - queue->time_last);
+        if (offset > window) {
+            if (offset <= LWBTN_TIME_HALF) {
+                break; /* Edge happened after current time, keep it for next processing */
+            }
+            edge.time = queue->time_last; /* Edge is older than last processing */
+        }
+        if (edge.btn_idx < lwobj->btns_cnt) {
+            prv_edge_replay_btn(lwobj, &lwobj->btns[edge.btn_idx], edge.state, edge.time);
+        }
+        LWBTN_MEMORY_BARRIER(); /* Record must be read before slot is released */
+        r = (uint16_t)(r + 1U);
+        queue->r = r;
+    }
+}
+
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__ */
+
+/**
+ * \brief           Process the button information and state
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       btn: Button instance to process
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_process_btn(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
+#if LWBTN_CFG_USE_EDGE_QUEUE
+    /* Timeouts since last edge are processed at their exact time */
+    if (btn->flags & LWBTN_FLAG_EDGE) {
+        prv_edge_process_timeouts(lwobj, btn, mstime);
+    }
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+#if LWBTN_CFG_USE_TRACE
+    uint8_t state = prv_btn_get_state(lwobj, btn) ? 1 : 0;
+
+    if (lwobj->trace != NULL) {
+        prv_trace_input(lwobj, btn, state, mstime);
+    }
+    prv_process_btn_state(lwobj, btn, state, mstime);
+#else
+    prv_process_btn_state(lwobj, btn, prv_btn_get_state(lwobj, btn) ? 1 : 0, mstime);
+#endif /* LWBTN_CFG_USE_TRACE */
+}
+
+#if LWBTN_CFG_USE_ACTIVE_SET || LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__
+
+/**
+ * \brief           Get mask of valid button bits in specific bitmap word
+ * \param[in]       btns_cnt: Number of buttons in the group
+ * \param[in]       w_idx: Word index
+ * \return          Mask with bits set for existing buttons
+ */
+static lwbtn_word_t
+prv_bitmap_word_mask(uint16_t btns_cnt, size_t w_idx) {
+    size_t left = btns_cnt - w_idx * LWBTN_WORD_BITS;
+    return left >= LWBTN_WORD_BITS ? ~(lwbtn_word_t)0 : (((lwbtn_word_t)1 << left) - 1U);
+}
+
+#endif /* LWBTN_CFG_USE_ACTIVE_SET || LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__
+
+/**
+ * \brief           Unlink the button from its timing wheel slot
+ * \param[in]       wheel: Timing wheel
+ * \param[in]       index: Button index in the group
+ */
+static void
+prv_wheel_unlink(lwbtn_wheel_t* wheel, uint16_t index) {
+    lwbtn_wheel_node_t* node = &wheel->nodes[index];
+
+    if (node->prev == LWBTN_WHEEL_UNLINKED) {
+        return;
+    }
+    if (node->prev == LWBTN_WHEEL_NONE) {
+        wheel->slots[node->deadline & (wheel->slots_cnt - 1U)] = node->next;
+    } else {
+        wheel->nodes[node->prev].next = node->next;
+    }
+    if (node->next != LWBTN_WHEEL_NONE) {
+        wheel->nodes[node->next].prev = node->prev;
+    }
+    node->prev = LWBTN_WHEEL_UNLINKED;
+}
+
+/**
+ * \brief           Link the button to timing wheel slot of its deadline
+ * \param[in]       wheel: Timing wheel
+ * \param[in]       index: Button index in the group, not linked to any slot
+ * \param[in]       deadline: Time at which button must be processed
+ * \return          `1` on success, `0` when deadline is not after already checked slots
+ */
+static uint8_t
+prv_wheel_link(lwbtn_wheel_t* wheel, uint16_t index, lwbtn_time_t deadline) {
+    lwbtn_wheel_node_t* node = &wheel->nodes[index];
+    uint16_t* head = &wheel->slots[deadline & (wheel->slots_cnt - 1U)];
+
+    if ((lwbtn_time_t)(deadline - wheel->time - 1U) >= LWBTN_TIME_HALF) {
+        return 0;
+    }
+    node->deadline = deadline;
+    node->prev = LWBTN_WHEEL_NONE;
+    node->next = *head;
+    if (*head != LWBTN_WHEEL_NONE) {
+        wheel->nodes[*head].prev = index;
+    }
+    *head = index;
+    return 1;
+}
+
+/**
+ * \brief           Move buttons with expired deadline from timing wheel to active set
+ *
+ * Only slots, that have passed since previous call, are checked.
+ * Every slot is checked once, when full wheel turn has passed, or time went backwards.
+ *
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_wheel_advance(lwbtn_t* lwobj, lwbtn_time_t mstime) {
+    lwbtn_wheel_t* wheel = &lwobj->wheel;
+    lwbtn_time_t ticks = (lwbtn_time_t)(mstime - wheel->time);
+    uint16_t index, next;
+
+    if (ticks > wheel->slots_cnt) {
+        ticks = wheel->slots_cnt;
+    }
+    for (lwbtn_time_t tick = 1; tick <= ticks; ++tick) {
+        for (index = wheel->slots[(wheel->time + tick) & (wheel->slots_cnt - 1U)]; index != LWBTN_WHEEL_NONE;
+             index = next) {
+            next = wheel->nodes[index].next;
+            if ((lwbtn_time_t)(mstime - wheel->nodes[index].deadline) <= LWBTN_TIME_HALF) {
+                prv_wheel_unlink(wheel, index);
+                LWBTN_SHARED_OR(&lwobj->active[index / LWBTN_WORD_BITS], (lwbtn_word_t)1 << (index % LWBTN_WORD_BITS));
+            }
+        }
+    }
+    wheel->time = mstime;
+}
+
+/**
+ * \brief           Get the earliest deadline of the group with timing wheel
+ *
+ * Buttons in active set are due immediately. Slots are checked in order of time,
+ * until the earliest button of current wheel turn is found.
+ *
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       mstime: Current system time in milliseconds
+ * \param[out]      deadline: Pointer to output variable to write deadline time to
+ * \return          Member of \ref lwbtn_deadline_t enumeration
+ */
+static lwbtn_deadline_t
+prv_wheel_get_next_deadline(lwbtn_t* lwobj, lwbtn_time_t mstime, lwbtn_time_t* deadline) {
+    lwbtn_wheel_t* wheel = &lwobj->wheel;
+    lwbtn_time_t offset, offset_min = 0, remaining;
+    uint8_t pending = 0;
+
+    for (size_t w_idx = 0; w_idx < LWBTN_BITMAP_WORDS(lwobj->btns_cnt); ++w_idx) {
+        if (LWBTN_SHARED_LOAD(&lwobj->active[w_idx]) != 0) {
+            if (deadline != NULL) {
+                *deadline = mstime;
+            }
+            return LWBTN_DEADLINE_PENDING;
+        }
+    }
+    for (lwbtn_time_t tick = 1; tick <= wheel->slots_cnt; ++tick) {
+        for (uint16_t index = wheel->slots[(wheel->time + tick) & (wheel->slots_cnt - 1U)]; index != LWBTN_WHEEL_NONE;
+             index = wheel->nodes[index].next) {
+            offset = (lwbtn_time_t)(wheel->nodes[index].deadline - wheel->time);
+            if (!pending || offset < offset_min) {
+                offset_min = offset;
+                pending = 1;
+            }
+        }
+
+        /* Buttons in later slots expire later */
+        if (pending && offset_min <= tick) {
+            break;
+        }
+    }
+    if (!pending) {
+        return LWBTN_DEADLINE_IDLE;
+    }
+    if (deadline != NULL) {
+        remaining = (lwbtn_time_t)(wheel->time + offset_min - mstime);
+        *deadline = remaining > LWBTN_TIME_HALF ? mstime : (lwbtn_time_t)(mstime + remaining);
+    }
+    return LWBTN_DEADLINE_PENDING;
+}
+
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__
+
+/**
+ * \brief           Process the button from active set
+ * 
+ * Button is removed from active set before processing, and added back
+ * when it does not only wait for next input edge. Edge notification from other context,
+ * that comes during processing, therefore keeps the button in active set.
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       index: Button index in the group
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_active_set_process_btn(lwbtn_t* lwobj, size_t index, lwbtn_time_t mstime) {
+    lwbtn_time_t remaining;
+    lwbtn_word_t mask = (lwbtn_word_t)1 << (index % LWBTN_WORD_BITS);
+
+    LWBTN_SHARED_AND(&lwobj->active[index / LWBTN_WORD_BITS], ~mask);
+#if LWBTN_CFG_USE_TIMING_WHEEL
+    if (lwobj->wheel.slots != NULL) {
+        prv_wheel_unlink(&lwobj->wheel, (uint16_t)index);
+    }
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL */
+    prv_process_btn(lwobj, &lwobj->btns[index], mstime);
+    if (prv_btn_get_remaining(lwobj, &lwobj->btns[index], mstime, &remaining)) {
+#if LWBTN_CFG_USE_TIMING_WHEEL
+        /* Button waits for timeout, wheel moves it back to active set when it expires */
+        if (lwobj->wheel.slots != NULL && remaining > 0
+            && prv_wheel_link(&lwobj->wheel, (uint16_t)index, (lwbtn_time_t)(mstime + remaining))) {
+            return;
+        }
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL */
+        LWBTN_SHARED_OR(&lwobj->active[index / LWBTN_WORD_BITS], mask);
+    }
+}
+
+#endif /* LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__
+
+/**
+ * \brief           Read group state mask and compare it against previously processed one
+ * 
+ * Buttons with changed input state are added to the active set
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ */
+static void
+prv_state_mask_update(lwbtn_t* lwobj) {
+    uint16_t words_cnt = (uint16_t)LWBTN_BITMAP_WORDS(lwobj->btns_cnt);
+    lwbtn_word_t *curr = lwobj->state_mask, *prev = lwobj->state_mask + words_cnt, chg;
+
+    if (lwobj->get_state_mask_fn != NULL) {
+        lwobj->get_state_mask_fn(lwobj, curr, words_cnt);
+    }
+    for (size_t w_idx = 0; w_idx < words_cnt; ++w_idx) {
+        chg = (curr[w_idx] ^ prev[w_idx]) & prv_bitmap_word_mask(lwobj->btns_cnt, w_idx);
+        prev[w_idx] = curr[w_idx];
+#if LWBTN_CFG_USE_ACTIVE_SET
+        if (lwobj->active != NULL && chg != 0) {
+            LWBTN_SHARED_OR(&lwobj->active[w_idx], chg);
+        }
+#else  /* LWBTN_CFG_USE_ACTIVE_SET */
+        (void)chg;
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+    }
+}
+
+#endif /* LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__ */
+
+/**
+ * \brief           Prepare group inputs before buttons are processed
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \return          `1` when group can be processed, `0` otherwise
+ */
+static uint8_t
+prv_process_prepare(lwbtn_t* lwobj) {
+#if LWBTN_CFG_USE_STATE_MASK
+    /* Read all inputs at once */
+    if (lwobj->state_mask != NULL) {
+        prv_state_mask_update(lwobj);
+    }
+#if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK
+    else if (lwobj->get_state_fn == NULL
+#if LWBTN_CFG_USE_IDX_CALLBACKS
+             && lwobj->get_state_idx_fn == NULL
+#endif /* LWBTN_CFG_USE_IDX_CALLBACKS */
+    ) {
+        return 0;
+    }
+#endif /* LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK */
+#elif LWBTN_CFG_USE_IDX_CALLBACKS && LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_CALLBACK
+    /* One of get state functions is a must in callback-only mode */
+    if (lwobj->get_state_fn == NULL && lwobj->get_state_idx_fn == NULL) {
+        return 0;
+    }
+#endif /* LWBTN_CFG_USE_STATE_MASK */
+    (void)lwobj;
+    return 1;
+}
+
+/**
+ * \brief           Process range of buttons in the group
+ * 
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       start: Index of first button to process.
+ *                      Must be multiple of \ref LWBTN_WORD_BITS when active set is used
+ * \param[in]       end: Index of first button after the range
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_process_range(lwbtn_t* lwobj, size_t start, size_t end, lwbtn_time_t mstime) {
+#if LWBTN_CFG_USE_ACTIVE_SET
+    /* Process only buttons from active set */
+    if (lwobj->active != NULL) {
+        for (size_t w_idx = start / LWBTN_WORD_BITS; w_idx < LWBTN_BITMAP_WORDS(end); ++w_idx) {
+            for (lwbtn_word_t word = LWBTN_SHARED_LOAD(&lwobj->active[w_idx]); word != 0; word &= word - 1U) {
+                prv_active_set_process_btn(lwobj, w_idx * LWBTN_WORD_BITS + prv_ctz(word), mstime);
+            }
+        }
+        return;
+    }
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+
+    /* Process all buttons */
+    for (size_t index = start; index < end; ++index) {
+        prv_process_btn(lwobj, &lwobj->btns[index], mstime);
+    }
+}
+
+/**
+ * \brief           Set default dynamic parameters to array of buttons
+ * \param[in]       btns: Array of buttons
+ * \param[in]       btns_cnt: Number of buttons in array
+ */
+static void
+prv_btns_set_defaults(lwbtn_btn_t* btns, uint16_t btns_cnt) {
+#if !LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC
+    for (size_t i = 0; i < btns_cnt; ++i) {
+#if LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC
+        btns[i].time_debounce = LWBTN_CFG_TIME_DEBOUNCE_PRESS;
+#endif /* LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC */
+#if LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC
+        btns[i].time_debounce_release = LWBTN_CFG_TIME_DEBOUNCE_RELEASE;
+#endif /* LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC
+        btns[i].time_click_pressed_min = LWBTN_CFG_TIME_CLICK_MIN;
+#endif /* LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC
+        btns[i].time_click_pressed_max = LWBTN_CFG_TIME_CLICK_MAX;
+#endif /* LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC
+        btns[i].time_click_multi_max = LWBTN_CFG_TIME_CLICK_MULTI_MAX;
+#endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC */
+#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC
+        btns[i].time_keepalive_period = LWBTN_CFG_TIME_KEEPALIVE_PERIOD;
+#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC */
+#if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC
+        btns[i].max_consecutive = LWBTN_CFG_CLICK_MAX_CONSECUTIVE;
+#endif /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC */
+    }
+#endif /* !LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC */
+#if LWBTN_CFG_USE_EVT_MASK || LWBTN_CFG_USE_BTN_FEATURES
+    for (size_t i = 0; i < btns_cnt; ++i) {
+#if LWBTN_CFG_USE_EVT_MASK
+        btns[i].evt_mask = LWBTN_EVT_MASK_ALL;
+#endif /* LWBTN_CFG_USE_EVT_MASK */
+#if LWBTN_CFG_USE_BTN_FEATURES
+        btns[i].features = LWBTN_BTN_FEATURES_ALL;
+#endif /* LWBTN_CFG_USE_BTN_FEATURES */
+    }
+#endif /* LWBTN_CFG_USE_EVT_MASK || LWBTN_CFG_USE_BTN_FEATURES */
+    (void)btns;
+    (void)btns_cnt;
+}
+
+#if LWBTN_CFG_USE_TIMER || __DOXYGEN__
+
+/**
+ * \brief           Calculate next deadline of the group and update the timer, when deadline has changed
+ * \param[in]       lwobj: LwBTN instance
+ * \param[in]       mstime: Current milliseconds system time
+ */
+static void
+prv_timer_update(lwbtn_t* lwobj, lwbtn_time_t mstime) {
+    lwbtn_time_t time = 0;
+    lwbtn_deadline_t status;
+
+    if (lwobj->set_timer_fn == NULL) {
+        return;
+    }
+    lwobj->timer_mstime = mstime;
+    status = lwbtn_get_next_deadline(lwobj, mstime, &time);
+    if (status != (lwbtn_deadline_t)lwobj->timer_status
+        || (status == LWBTN_DEADLINE_PENDING && time != lwobj->timer_time)) {
+        lwobj->timer_status = (uint8_t)status;
+        lwobj->timer_time = time;
+        lwobj->set_timer_fn(lwobj, status, time);
+    }
+}
+
+#endif /* LWBTN_CFG_USE_TIMER || __DOXYGEN__ */
+
+/**
+ * \brief           Initialize button manager
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btns: Array of buttons to process
+ * \param[in]       btns_cnt: Number of buttons to process
+ * \param[in]       get_state_fn: Pointer to function providing button state on demand.
+ *                      May be set to `NULL` when \ref LWBTN_CFG_GET_STATE_MODE is set to manual,
+ *                      or when \ref LWBTN_CFG_USE_STATE_MASK is enabled and group state mask is used instead,
+ *                      or when \ref LWBTN_CFG_USE_IDX_CALLBACKS is enabled and get state by index function is used.
+ * \param[in]       evt_fn: Button event function callback.
+ *                      May be set to `NULL` when \ref LWBTN_CFG_USE_EVT_QUEUE is enabled and events are read from the queue
+ *                      or when \ref LWBTN_CFG_USE_EVT_BATCH is enabled and events are sent to batched events function
+ *                      or when \ref LWBTN_CFG_USE_EVT_INFO is enabled and events are sent to event info function
+ *                      or when \ref LWBTN_CFG_USE_IDX_CALLBACKS is enabled and events are sent to index function
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_init_ex(lwbtn_t* lwobj, lwbtn_btn_t* btns, uint16_t btns_cnt, lwbtn_get_state_fn get_state_fn,
+              lwbtn_evt_fn evt_fn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (btns == NULL || btns_cnt == 0
+#if !LWBTN_EVT_FN_OPTIONAL
+        || evt_fn == NULL /* Parameter is optional when events are sent to the queue, batch or other function */
+#endif                    /* !LWBTN_EVT_FN_OPTIONAL */
+#if LWBTN_GET_STATE_FN_REQUIRED
+        || get_state_fn == NULL /* Parameter is a must only in callback-only mode */
+#endif                          /* LWBTN_GET_STATE_FN_REQUIRED */
+    ) {
+        return 0;
+    }
+
+    LWBTN_MEMSET(lwobj, 0x00, sizeof(*lwobj));
+    lwobj->btns = btns;
+    lwobj->btns_cnt = btns_cnt;
+    lwobj->evt_fn = evt_fn;
+#if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL
+    lwobj->get_state_fn = get_state_fn;
+#else
+    (void)get_state_fn; /* May be unused */
+#endif /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_MANUAL */
+#if LWBTN_CFG_USE_PROFILES
+    lwobj->profiles = &lwbtn_profile_default;
+    lwobj->profiles_cnt = 1;
+#endif /* LWBTN_CFG_USE_PROFILES */
+
+    prv_btns_set_defaults(btns, btns_cnt);
+
+    return 1;
+}
+
+/**
+ * \brief           Button processing function, that reads the inputs and makes actions accordingly.
+ * 
+ * It checks state of all the buttons, linked to the specific LwBTN instance (group).
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       mstime: Current system time in milliseconds
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_process_ex(lwbtn_t* lwobj, lwbtn_time_t mstime) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (!prv_process_prepare(lwobj)) {
+        return 0;
+    }
+#if LWBTN_CFG_USE_EDGE_QUEUE
+    if (lwobj->edge_queue.edges != NULL) {
+        prv_edge_queue_replay(lwobj, mstime);
+    }
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+#if LWBTN_CFG_USE_TIMING_WHEEL
+    if (lwobj->active != NULL && lwobj->wheel.slots != NULL) {
+        prv_wheel_advance(lwobj, mstime);
+    }
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL */
+    prv_process_range(lwobj, 0, lwobj->btns_cnt, mstime);
+#if LWBTN_CFG_USE_EDGE_QUEUE
+    lwobj->edge_queue.time_last = mstime;
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+#if LWBTN_CFG_USE_EVT_BATCH
+    prv_evt_batch_deliver(lwobj);
+#endif /* LWBTN_CFG_USE_EVT_BATCH */
+#if LWBTN_CFG_USE_TIMER
+    prv_timer_update(lwobj, mstime);
+#endif /* LWBTN_CFG_USE_TIMER */
+    return 1;
+}
+
+/**
  * \brief           Process single button instance from the specific LwOBJ instance (group).
  * 
- * This feature can be used if application wants to process the button events only
- * when interrupt hits (as a trigger). It gives user higher autonomy to decide which 
- * and when it will call specific button processing.
+ * This feature can be used if application wants to process the button events only
+ * when interrupt hits (as a trigger). It gives user higher autonomy to decide which 
+ * and when it will call specific button processing.
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button object. Must not be set to `NULL`
+ * \param[in]       mstime: Current system time in milliseconds
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_process_btn_ex(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
+    if (btn != NULL) {
+        lwobj = LWBTN_GET_LWOBJ(lwobj);
+#if LWBTN_CFG_USE_ACTIVE_SET
+        if (lwobj->active != NULL && btn >= lwobj->btns && btn < &lwobj->btns[lwobj->btns_cnt]) {
+            prv_active_set_process_btn(lwobj, (size_t)(btn - lwobj->btns), mstime);
+        } else
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+        {
+            prv_process_btn(lwobj, btn, mstime);
+        }
+#if LWBTN_CFG_USE_EVT_BATCH
+        prv_evt_batch_deliver(lwobj);
+#endif /* LWBTN_CFG_USE_EVT_BATCH */
+#if LWBTN_CFG_USE_TIMER
+        prv_timer_update(lwobj, mstime);
+#endif /* LWBTN_CFG_USE_TIMER */
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Set button state to either "active" or "inactive".
+ * 
+ * When \ref LWBTN_CFG_USE_ATOMIC is enabled, state is written with single atomic store,
+ * and function can be called from any context while the group is being processed.
+ * 
+ * \param[in]       btn: Button instance
+ * \param[in]       state: New button state. `1` is for active (pressed), `0` is for inactive (released).
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_set_btn_state(lwbtn_btn_t* btn, uint8_t state) {
+#if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK
+#if LWBTN_CFG_USE_ATOMIC
+    LWBTN_SHARED_STORE(&btn->curr_state,
+                       (uint8_t)(LWBTN_CURR_STATE_MANUAL | (state ? LWBTN_CURR_STATE_ACTIVE : 0)));
+#else  /* LWBTN_CFG_USE_ATOMIC */
+    btn->curr_state = state;
+    btn->flags |= LWBTN_FLAG_MANUAL_STATE;
+#endif /* LWBTN_CFG_USE_ATOMIC */
+    return 1;
+#else  /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK */
+    (void)btn;
+    (void)state;
+    return 0;
+#endif /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK */
+}
+
+/**
+ * \brief           Check if button is active.
+ * Active is considered when initial debounce period has been a pass.
+ * This is the period between on-press and on-release events.
+ * 
+ * \param[in]       btn: Button handle to check
+ * \return          `1` if active, `0` otherwise
+ */
+uint8_t
+lwbtn_is_btn_active(const lwbtn_btn_t* btn) {
+    return btn != NULL && (btn->flags & LWBTN_FLAG_ONPRESS_SENT);
+}
+
+/**
+ * \brief           Reset button[s] state to default
+ * 
+ *                  When reset is called, and if button is pressed (active),
+ *                  no further events will be called up until we receive
+ *                  the new valid press action.
+ * 
+ *                  A typical use case would be when application needs to react
+ *                  on a long press (several keep alive events).
+ *                  
+ *                  Consider the use case where user runs the GUI and long press changes the screen.
+ *                  The new screen has its own button handling method, which performs some other action (eg. "go home" action).
+ *                  
+ *                  Calling the reset function will prevent new screen to continue receiving the events
+ *                  and forces the user to release the button and press it again.
+ * 
+ * \note            If button is reset during active time, there will be no further events
+ *                  for this button sent to the application, up until a new valid on-press is detected
+ * 
+ * \note            With active set, reset buttons are added back to it.
+ *                  Single button, that is not part of default group, must be followed
+ *                  by \ref lwbtn_notify_btn_change call to its group
+ * 
+ * \note            With timer function, timer is updated for reset buttons,
+ *                  that wait for their first inactive state, also when it is already stopped.
+ *                  Reset of single button updates the timer only when button is part of default group
+ *                  or of `lwobj`, if set
+ * 
+ * \param           lwobj: Object to reset buttons. Set to non-NULL to reset
+ *                      all buttons in an object
+ * \param           btn: Button object to reset. Optional parameter.
+ *                      When non-NULL, button is reset
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_reset(lwbtn_t* lwobj, lwbtn_btn_t* btn) {
+    for (size_t idx = 0; idx < (lwobj != NULL ? lwobj->btns_cnt : 0); ++idx) {
+        lwobj->btns[idx].flags &= ~LWBTN_FLAG_FIRST_INACTIVE_RCVD;
+    }
+    if (btn != NULL) {
+        btn->flags &= ~LWBTN_FLAG_FIRST_INACTIVE_RCVD;
+    }
+
+#if LWBTN_CFG_USE_ACTIVE_SET
+    /* Reset buttons must be processed again, to receive their first inactive state */
+    if (lwobj != NULL && lwobj->active != NULL) {
+        for (size_t w_idx = 0; w_idx < LWBTN_BITMAP_WORDS(lwobj->btns_cnt); ++w_idx) {
+            LWBTN_SHARED_OR(&lwobj->active[w_idx], prv_bitmap_word_mask(lwobj->btns_cnt, w_idx));
+        }
+    }
+    if (btn != NULL) {
+        lwbtn_notify_btn_change(lwobj, btn);
+    }
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+#if LWBTN_CFG_USE_TIMER
+    /* Released buttons must be processed before next input edge, even when timer is stopped */
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+    if (btn == NULL || (btn >= lwobj->btns && btn < lwobj->btns + lwobj->btns_cnt)) {
+        prv_timer_update(lwobj, lwobj->timer_mstime);
+    }
+#endif /* LWBTN_CFG_USE_TIMER */
+    return 1;
+}
+
+/**
+ * \brief           Get the earliest time at which processing can change state of any button in the group.
+ * 
+ * Application can use this information for tickless operation. Instead of calling
+ * \ref lwbtn_process_ex periodically, it only needs to call it:
+ * 
+ * - On every input edge (change of any input state)
+ * - At the returned deadline time, when \ref LWBTN_DEADLINE_PENDING is returned
+ * 
+ * \note            Query must be done after processing, as it relies on last processed input states
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       mstime: Current system time in milliseconds
+ * \param[out]      deadline: Pointer to output variable to write deadline time to.
+ *                      It is equal to `mstime` when processing is due immediately.
+ *                      Not modified when group is idle
+ * \return          \ref LWBTN_DEADLINE_PENDING when deadline is valid,
+ *                  \ref LWBTN_DEADLINE_IDLE when all buttons wait for next input edge
+ */
+lwbtn_deadline_t
+lwbtn_get_next_deadline(lwbtn_t* lwobj, lwbtn_time_t mstime, lwbtn_time_t* deadline) {
+    lwbtn_time_t remaining, remaining_min = 0;
+    uint8_t pending = 0;
+
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+#if LWBTN_CFG_USE_EDGE_QUEUE
+    /* Queued edges are replayed with next processing */
+    if (lwobj->edge_queue.edges != NULL && lwobj->edge_queue.r != lwobj->edge_queue.w) {
+        if (deadline != NULL) {
+            *deadline = mstime;
+        }
+        return LWBTN_DEADLINE_PENDING;
+    }
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+#if LWBTN_CFG_USE_TIMING_WHEEL
+    if (lwobj->active != NULL && lwobj->wheel.slots != NULL) {
+        return prv_wheel_get_next_deadline(lwobj, mstime, deadline);
+    }
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL */
+    for (size_t index = 0; index < lwobj->btns_cnt; ++index) {
+#if LWBTN_CFG_USE_ACTIVE_SET
+        /* Buttons outside active set wait for input edge */
+        if (lwobj->active != NULL) {
+            lwbtn_word_t word = LWBTN_SHARED_LOAD(&lwobj->active[index / LWBTN_WORD_BITS]) >> (index % LWBTN_WORD_BITS);
+            if (word == 0) {
+                index |= LWBTN_WORD_BITS - 1U; /* Skip the rest of the word */
+                continue;
+            }
+            index += prv_ctz(word);
+            if (index >= lwobj->btns_cnt) {
+                break;
+            }
+        }
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+        if (prv_btn_get_remaining(lwobj, &lwobj->btns[index], mstime, &remaining)) {
+            if (!pending || remaining < remaining_min) {
+                remaining_min = remaining;
+                pending = 1;
+            }
+        }
+    }
+    if (!pending) {
+        return LWBTN_DEADLINE_IDLE;
+    }
+    if (deadline != NULL) {
+        *deadline = (lwbtn_time_t)(mstime + remaining_min);
+    }
+    return LWBTN_DEADLINE_PENDING;
+}
+
+#if LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__
+
+/**
+ * \brief           Enable active set processing for the group
+ * 
+ * When enabled, group keeps bitmap of buttons that are not idle: in debounce, pressed or waiting for click timeout.
+ * Processing function only processes buttons from active set, skipping idle ones completely,
+ * including the call to get state function.
+ * 
+ * Idle button is added back to the active set with \ref lwbtn_notify_btn_change,
+ * that application shall call on every input edge of the button.
+ * 
+ * \note            Function shall be called after \ref lwbtn_init_ex. All buttons are initially in active set
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       bitmap: Bitmap memory with at least \ref LWBTN_BITMAP_WORDS `(btns_cnt)` words.
+ *                      Set to `NULL` to disable active set and process all buttons
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_active_set_init(lwbtn_t* lwobj, lwbtn_word_t* bitmap) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (bitmap != NULL) {
+        for (size_t w_idx = 0; w_idx < LWBTN_BITMAP_WORDS(lwobj->btns_cnt); ++w_idx) {
+            bitmap[w_idx] = prv_bitmap_word_mask(lwobj->btns_cnt, w_idx);
+        }
+    }
+    lwobj->active = bitmap;
+    return 1;
+}
+
+/**
+ * \brief           Notify the group that input state of the button may have changed.
+ * 
+ * Function adds the button to the active set, to be processed in next processing call.
+ * It shall be called on every input edge, for instance from GPIO interrupt
+ * or after \ref lwbtn_set_btn_state call.
+ * 
+ * \note            Function must not preempt processing of the same group,
+ *                  unless \ref LWBTN_CFG_USE_ATOMIC is enabled
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button object from the group
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_notify_btn_change(lwbtn_t* lwobj, lwbtn_btn_t* btn) {
+    size_t index;
+
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+    if (btn == NULL || btn < lwobj->btns || btn >= &lwobj->btns[lwobj->btns_cnt]) {
+        return 0;
+    }
+    if (lwobj->active != NULL) {
+        index = (size_t)(btn - lwobj->btns);
+        LWBTN_SHARED_OR(&lwobj->active[index / LWBTN_WORD_BITS], (lwbtn_word_t)1 << (index % LWBTN_WORD_BITS));
+    }
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_ACTIVE_SET || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__
+
+/**
+ * \brief           Enable group state mask input
+ * 
+ * When enabled, processing function reads input states of all buttons at once,
+ * either with single call to `get_state_mask_fn` or from the last mask set with \ref lwbtn_set_group_state_mask.
+ * Per-button get state function and manually set button states are not used anymore.
+ * 
+ * Mask is compared against previously processed one, and buttons with changed input
+ * are added to the active set, when it is enabled with \ref lwbtn_active_set_init.
+ * Combined with active set, only buttons with input change or pending timeout are processed.
+ * 
+ * \note            Function shall be called after \ref lwbtn_init_ex
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       mask: Mask memory with at least \ref LWBTN_STATE_MASK_WORDS `(btns_cnt)` words.
+ *                      Set to `NULL` to disable group state mask input
+ * \param[in]       get_state_mask_fn: Pointer to function providing group state mask on every processing call.
+ *                      Set to `NULL` when application sets the mask with \ref lwbtn_set_group_state_mask
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_state_mask_init(lwbtn_t* lwobj, lwbtn_word_t* mask, lwbtn_get_state_mask_fn get_state_mask_fn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (mask != NULL) {
+        LWBTN_MEMSET(mask, 0x00, LWBTN_STATE_MASK_WORDS(lwobj->btns_cnt) * sizeof(*mask));
+    }
+    lwobj->state_mask = mask;
+    lwobj->get_state_mask_fn = get_state_mask_fn;
+    return 1;
+}
+
+/**
+ * \brief           Set input states of all buttons in the group
+ * 
+ * New states are taken into account on next call to \ref lwbtn_process_ex
+ * 
+ * \note            Function must not preempt processing of the same group
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       mask: Input states with \ref LWBTN_BITMAP_WORDS `(btns_cnt)` words.
+ *                      Bit `n` of word `w` belongs to button with index `w * LWBTN_WORD_BITS + n`
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_set_group_state_mask(lwbtn_t* lwobj, const lwbtn_word_t* mask) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (mask == NULL || lwobj->state_mask == NULL) {
+        return 0;
+    }
+    LWBTN_MEMCPY(lwobj->state_mask, mask, LWBTN_BITMAP_WORDS(lwobj->btns_cnt) * sizeof(*mask));
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_STATE_MASK || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Enable event queue of the group
+ * 
+ * When enabled, processing function writes events to the queue instead of calling event function.
+ * Application reads them with \ref lwbtn_poll_event, from the context of its choice.
+ * Processing (producer) and polling (consumer) may run in different contexts without locks,
+ * for instance processing from timer interrupt and polling from main loop.
+ * 
+ * \note            Function shall be called after \ref lwbtn_init_ex, before processing starts
+ * \note            With \ref LWBTN_EVT_QUEUE_DROP_OLDEST policy, application shall poll the queue
+ *                  at least once per `65536 - size` generated events
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       recs: Records array. Set to `NULL` to disable the queue and use event function again
+ * \param[in]       size: Number of records in array. Must be power of `2`, between `2` and `32768`
+ * \param[in]       policy: Overflow policy, applied when queue is full
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_evt_queue_init(lwbtn_t* lwobj, lwbtn_evt_rec_t* recs, uint16_t size, lwbtn_evt_queue_policy_t policy) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (recs != NULL && (size < 2 || size > 0x8000 || (size & (size - 1U)) != 0)) {
+        return 0;
+    }
+    LWBTN_MEMSET(&lwobj->evt_queue, 0x00, sizeof(lwobj->evt_queue));
+    lwobj->evt_queue.size = size;
+    lwobj->evt_queue.policy = (uint8_t)policy;
+    lwobj->evt_queue.recs = recs;
+    return 1;
+}
+
+/**
+ * \brief           Read oldest event from the event queue
+ * 
+ * \note            Function must only be called from one context at a time
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[out]      rec: Pointer to record to copy event to
+ * \return          `1` when event has been read, `0` when queue is empty or not enabled
+ */
+uint8_t
+lwbtn_poll_event(lwbtn_t* lwobj, lwbtn_evt_rec_t* rec) {
+    lwbtn_evt_queue_t* queue;
+    uint16_t r, w;
+
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+    queue = &lwobj->evt_queue;
+    if (rec == NULL || queue->recs == NULL) {
+        return 0;
+    }
+    r = queue->r;
+    for (;;) {
+        w = queue->w;
+        if (w == r) {
+            queue->r = r;
+            return 0;
+        }
+        if (queue->policy == LWBTN_EVT_QUEUE_DROP_OLDEST && (uint16_t)(w - r) >= queue->size) {
+            /* Oldest records have been overwritten, next slot may be written at any moment */
+            r = (uint16_t)(w - queue->size + 1U);
+        }
+        LWBTN_MEMORY_BARRIER(); /* Index must be read before the record */
+        *rec = queue->recs[r & (queue->size - 1U)];
+        LWBTN_MEMORY_BARRIER(); /* Record must be read before index is checked again */
+
+        /* Record is valid, unless producer started to overwrite it during the copy */
+        if (queue->policy != LWBTN_EVT_QUEUE_DROP_OLDEST || (uint16_t)(queue->w - r) < queue->size) {
+            break;
+        }
+        r = (uint16_t)(r + 1U);
+    }
+    queue->r = (uint16_t)(r + 1U);
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_EVT_QUEUE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__
+
+/**
+ * \brief           Enable batched event delivery of the group
+ * 
+ * When enabled, events are collected while buttons are processed, and delivered at the end of processing call.
+ * When batched events function is set, it receives all events of the processing call with single call.
+ * Otherwise events are sent one by one to event function, with keep alive and click counters at the time of event.
+ * 
+ * \note            Events are dropped and counted, when batch gets full before the end of processing.
+ *                      Size shall cover the most events, that group can generate in one processing call
+ * \note            Event queue, when enabled with \ref lwbtn_evt_queue_init, takes precedence over the batch
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       recs: Records array. Set to `NULL` to disable the batch and send events immediately
+ * \param[in]       size: Number of records in array
+ * \param[in]       evt_batch_fn: Batched events function. Set to `NULL` to send events one by one to event function
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_evt_batch_init(lwbtn_t* lwobj, lwbtn_evt_rec_t* recs, uint16_t size, lwbtn_evt_batch_fn evt_batch_fn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (recs != NULL && size == 0) {
+        return 0;
+    }
+    LWBTN_MEMSET(&lwobj->evt_batch, 0x00, sizeof(lwobj->evt_batch));
+    lwobj->evt_batch.recs = recs;
+    lwobj->evt_batch.size = size;
+    lwobj->evt_batch.evt_batch_fn = evt_batch_fn;
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_EVT_BATCH || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__
+
+/**
+ * \brief           Set event info function of the group
+ * 
+ * Event info function is called instead of event function, with the record of the event.
+ * Record carries time of the event, press duration, time since last click and counters,
+ * captured at the time of event, so that application does not need to read button data.
+ * 
+ * \note            Event queue and event batch take precedence, their records carry the same data
+ * \note            Durations are calculated modulo `65536` when \ref LWBTN_CFG_USE_COMPACT is enabled
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       evt_info_fn: Event info function. Set to `NULL` to send events to event function again
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_evt_info_init(lwbtn_t* lwobj, lwbtn_evt_info_fn evt_info_fn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    lwobj->evt_info_fn = evt_info_fn;
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_EVT_INFO || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__
+
+/**
+ * \brief           Set index callbacks and user context of the group
+ * 
+ * Index functions are called instead of get state and event functions,
+ * with user context of the group and button index, instead of button pointer.
+ * 
+ * \note            Function shall be called after \ref lwbtn_init_ex
+ * \note            Event queue, event batch and event info function take precedence over event by index function
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       user: User context of the group, passed to index functions
+ * \param[in]       get_state_idx_fn: Get state by index function. Set to `NULL` to use get state function
+ * \param[in]       evt_idx_fn: Event by index function. Set to `NULL` to use event function
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_idx_callbacks_init(lwbtn_t* lwobj, void* user, lwbtn_get_state_idx_fn get_state_idx_fn,
+                         lwbtn_evt_idx_fn evt_idx_fn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    lwobj->user = user;
+    lwobj->get_state_idx_fn = get_state_idx_fn;
+    lwobj->evt_idx_fn = evt_idx_fn;
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_IDX_CALLBACKS || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__
+
+/**
+ * \brief           Set events, that button is subscribed to
+ * 
+ * Events, not in the mask, are not sent for the button. Button without keep alive subscription
+ * skips keep alive timing, and button without on-click subscription skips click detection.
+ * All buttons are subscribed to all events after \ref lwbtn_init_ex.
+ * 
+ * \note            Mask shall be changed while button is released.
+ *                      Keep alive and click counters are not maintained for unsubscribed events
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button instance
+ * \param[in]       evt_mask: Subscribed events, bitwise OR of \ref LWBTN_EVT_MASK values,
+ *                      or \ref LWBTN_EVT_MASK_ALL
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_set_btn_evt_mask(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t evt_mask) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (btn == NULL || btn < lwobj->btns || btn >= &lwobj->btns[lwobj->btns_cnt]) {
+        return 0;
+    }
+    btn->evt_mask = (uint8_t)(evt_mask & LWBTN_EVT_MASK_ALL);
+    prv_btn_features_changed(lwobj, btn);
+#if LWBTN_CFG_USE_ACTIVE_SET
+    /* Pending work of the button may have changed */
+    lwbtn_notify_btn_change(lwobj, btn);
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+    return 1;
+}
+
+/**
+ * \brief           Set table of event functions, one per event type
+ * 
+ * Event of type `evt` is sent to `evt_fns[evt]` function, instead of event function.
+ * Events with `NULL` entry are dropped.
+ * 
+ * \note            Event queue, event batch, event info and index functions take precedence over the table
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       evt_fns: Table of \ref LWBTN_EVT_CNT event functions.
+ *                      Set to `NULL` to send events to event function again
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_evt_fns_init(lwbtn_t* lwobj, const lwbtn_evt_fn* evt_fns) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    lwobj->evt_fns = evt_fns;
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_EVT_MASK || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__
+
+/**
+ * \brief           Set runtime features of the button
+ * 
+ * Button without any feature only debounces its input and sends on-press and on-release events,
+ * with shortest processing path. All buttons have all features enabled after \ref lwbtn_init_ex.
+ * 
+ * \note            Features shall be changed while button is released
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button instance
+ * \param[in]       features: Enabled features, bitwise OR of `LWBTN_BTN_FEATURE_*` flags
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_set_btn_features(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t features) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (btn == NULL || btn < lwobj->btns || btn >= &lwobj->btns[lwobj->btns_cnt]) {
+        return 0;
+    }
+    btn->features = (uint8_t)(features & LWBTN_BTN_FEATURES_ALL);
+    prv_btn_features_changed(lwobj, btn);
+#if LWBTN_CFG_USE_ACTIVE_SET
+    /* Pending work of the button may have changed */
+    lwbtn_notify_btn_change(lwobj, btn);
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_BTN_FEATURES || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__
+
+/**
+ * \brief           Get effective press debounce time of the button
+ * 
+ * Configured debounce time is used until first bounces of the button are measured
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button handle to check
+ * \return          Press debounce time in milliseconds
+ */
+uint16_t
+lwbtn_get_btn_debounce(lwbtn_t* lwobj, const lwbtn_btn_t* btn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    (void)lwobj; /* May be unused with fixed timings */
+    return btn != NULL ? (uint16_t)LWBTN_TIME_DEBOUNCE_PRESS_GET_MIN(lwobj, btn) : 0;
+}
+
+#endif /* LWBTN_CFG_USE_ADAPTIVE_DEBOUNCE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_TRACE || __DOXYGEN__
+
+/**
+ * \brief           Write variable length unsigned integer, 7 bits per byte, lowest bits first
+ * \param[out]      data: Output memory, at least `10` bytes
+ * \param[in]       val: Value to write
+ * \return          Number of written bytes
+ */
+static size_t
+prv_trace_varint_put(uint8_t* data, uint64_t val) {
+    size_t len = 0;
+
+    while (val >= 0x80U) {
+        data[len++] = (uint8_t)(val | 0x80U);
+        val >>= 7;
+    }
+    data[len++] = (uint8_t)val;
+    return len;
+}
+
+/**
+ * \brief           Read variable length unsigned integer
+ * \param[in]       data: Trace data
+ * \param[in]       len: Length of trace data in bytes
+ * \param[in,out]   pos: Read position, advanced after the integer
+ * \param[out]      val: Output variable to write value to
+ * \return          `1` on success, `0` when data ends or integer is too long
+ */
+static uint8_t
+prv_trace_varint_get(const uint8_t* data, size_t len, size_t* pos, uint64_t* val) {
+    *val = 0;
+    for (uint8_t shift = 0; *pos < len && shift < 64U; shift += 7U) {
+        uint8_t byte = data[(*pos)++];
+
+        *val |= (uint64_t)(byte & 0x7FU) << shift;
+        if (!(byte & 0x80U)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Initialize trace writer
+ * 
+ * Trace data is a sequence of records. Record starts with variable length integer of
+ * time difference to previous record, shifted left by `2` bits, with record code in lowest bits.
+ * Input and event records continue with variable length button index,
+ * event record ends with event type byte. First record stores time difference to `0`.
+ * 
+ * \param[in]       trace: Trace writer to initialize
+ * \param[in]       buff: Memory to write trace data to
+ * \param[in]       size: Size of memory in bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_trace_init(lwbtn_trace_t* trace, uint8_t* buff, size_t size) {
+    if (trace == NULL || (buff == NULL && size > 0)) {
+        return 0;
+    }
+    LWBTN_MEMSET(trace, 0x00, sizeof(*trace));
+    trace->buff = buff;
+    trace->size = size;
+    return 1;
+}
+
+/**
+ * \brief           Write one record to the trace
+ * 
+ * Records shall be written in time order. Record with time before last record
+ * is written with time of last record.
+ * 
+ * \param[in]       trace: Trace writer
+ * \param[in]       rec: Record to write
+ * \return          `1` on success, `0` when record does not fit to the memory anymore
+ */
+uint8_t
+lwbtn_trace_write(lwbtn_trace_t* trace, const lwbtn_trace_rec_t* rec) {
+    uint8_t data[LWBTN_TRACE_REC_MAX_LEN];
+    lwbtn_time_t delta;
+    uint8_t code;
+    size_t len;
+
+    if (trace == NULL || rec == NULL || trace->overflow) {
+        return 0;
+    }
+    switch (rec->type) {
+        case LWBTN_TRACE_REC_INPUT: code = rec->val ? LWBTN_TRACE_CODE_INPUT_1 : LWBTN_TRACE_CODE_INPUT_0; break;
+        case LWBTN_TRACE_REC_EVT: code = LWBTN_TRACE_CODE_EVT; break;
+        case LWBTN_TRACE_REC_MARK: code = LWBTN_TRACE_CODE_MARK; break;
+        default: return 0;
+    }
+
+    /* Time only goes forward */
+    delta = (lwbtn_time_t)(rec->time - trace->time);
+    if (delta > LWBTN_TIME_HALF) {
+        delta = 0;
+    }
+    len = prv_trace_varint_put(data, ((uint64_t)delta << 2) | code);
+    if (code != LWBTN_TRACE_CODE_MARK) {
+        len += prv_trace_varint_put(&data[len], rec->btn_idx);
+    }
+    if (code == LWBTN_TRACE_CODE_EVT) {
+        data[len++] = rec->val;
+    }
+
+    if (trace->size - trace->len < len) {
+        trace->overflow = 1;
+        return 0;
+    }
+    LWBTN_MEMCPY(&trace->buff[trace->len], data, len);
+    trace->len += len;
+    trace->time = (lwbtn_time_t)(trace->time + delta);
+    return 1;
+}
+
+/**
+ * \brief           Read next record from trace data
+ * 
+ * \param[in]       data: Trace data
+ * \param[in]       len: Length of trace data in bytes
+ * \param[in,out]   pos: Read position. Set to `0` before first record is read
+ * \param[in,out]   rec: Record to read to. Its time is time of previous record on input,
+ *                      and shall be set to `0` before first record is read
+ * \return          `1` when record has been read, `0` at the end of data or when data is not valid
+ */
+uint8_t
+lwbtn_trace_read(const uint8_t* data, size_t len, size_t* pos, lwbtn_trace_rec_t* rec) {
+    uint64_t tag, btn_idx = 0;
+    size_t p;
+
+    if (data == NULL || pos == NULL || rec == NULL) {
+        return 0;
+    }
+    p = *pos;
+    if (!prv_trace_varint_get(data, len, &p, &tag)) {
+        return 0;
+    }
+    if ((tag & 0x03U) != LWBTN_TRACE_CODE_MARK
+        && (!prv_trace_varint_get(data, len, &p, &btn_idx) || btn_idx > 0xFFFFU)) {
+        return 0;
+    }
+    if ((tag & 0x03U) == LWBTN_TRACE_CODE_EVT && p >= len) {
+        return 0;
+    }
+
+    rec->time = (lwbtn_time_t)(rec->time + (lwbtn_time_t)(tag >> 2));
+    rec->btn_idx = (uint16_t)btn_idx;
+    switch (tag & 0x03U) {
+        case LWBTN_TRACE_CODE_INPUT_0:
+        case LWBTN_TRACE_CODE_INPUT_1:
+            rec->type = LWBTN_TRACE_REC_INPUT;
+            rec->val = (uint8_t)(tag & 0x01U);
+            break;
+        case LWBTN_TRACE_CODE_EVT:
+            rec->type = LWBTN_TRACE_REC_EVT;
+            rec->val = data[p++];
+            break;
+        default:
+            rec->type = LWBTN_TRACE_REC_MARK;
+            rec->val = 0;
+            break;
+    }
+    *pos = p;
+    return 1;
+}
+
+/**
+ * \brief           Attach trace to the group, to record its input state changes and sent events
+ * 
+ * Input state is recorded when processing reads the state different from the last recorded one,
+ * all input states are considered inactive when trace is attached.
+ * Trace, recorded from group initialization on, replays with the same events.
+ * 
+ * \note            Input states of bit-sliced group are not recorded
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       trace: Trace writer, initialized with \ref lwbtn_trace_init. Set to `NULL` to stop recording
+ * \param[in]       states: Memory for last recorded input states,
+ *                      with at least \ref LWBTN_BITMAP_WORDS `(btns_cnt)` words
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_trace_attach(lwbtn_t* lwobj, lwbtn_trace_t* trace, lwbtn_word_t* states) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (trace != NULL && states == NULL) {
+        return 0;
+    }
+    if (trace != NULL) {
+        LWBTN_MEMSET(states, 0x00, LWBTN_BITMAP_WORDS(lwobj->btns_cnt) * sizeof(*states));
+    }
+    lwobj->trace_states = states;
+    lwobj->trace = trace;
+    return 1;
+}
+
+/**
+ * \brief           Check if time is after reference time
+ * \param[in]       time: Time to check
+ * \param[in]       ref: Reference time
+ * \return          `1` if time is after reference time, `0` otherwise
+ */
+static uint8_t
+prv_time_after(lwbtn_time_t time, lwbtn_time_t ref) {
+    lwbtn_time_t diff = (lwbtn_time_t)(time - ref);
+
+    return diff > 0 && diff <= LWBTN_TIME_HALF;
+}
+
+/**
+ * \brief           Replay trace through the group, as fast as possible
+ * 
+ * Input states are taken from input records instead of get state function or manually set states.
+ * Group is processed at the time of every record, and at every pending deadline between records,
+ * as returned by \ref lwbtn_get_next_deadline. Events are sent to the application as with live processing.
+ * Replay ends with the last record, importers write time mark record at the end of capture.
+ * 
+ * \note            Group shall be freshly initialized, time of the group starts at `0`
+ * 
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       data: Trace data
+ * \param[in]       len: Length of trace data in bytes
+ * \param[in]       states: Memory for replayed input states,
+ *                      with at least \ref LWBTN_BITMAP_WORDS `(btns_cnt)` words
+ * \return          `1` on success, `0` when data is not valid
+ */
+uint8_t
+lwbtn_trace_replay(lwbtn_t* lwobj, const uint8_t* data, size_t len, lwbtn_word_t* states) {
+    lwbtn_trace_rec_t rec = {0};
+    lwbtn_time_t now = 0, deadline;
+    size_t pos = 0;
+    uint8_t has_rec;
+
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+    if (data == NULL || states == NULL) {
+        return 0;
+    }
+    LWBTN_MEMSET(states, 0x00, LWBTN_BITMAP_WORDS(lwobj->btns_cnt) * sizeof(*states));
+    lwobj->replay_states = states;
+
+    /* All inputs are inactive when trace starts */
+    has_rec = lwbtn_trace_read(data, len, &pos, &rec);
+    if (has_rec && rec.time != 0) {
+        lwbtn_process_ex(lwobj, now);
+    }
+    while (has_rec) {
+        lwbtn_time_t time = rec.time;
+
+        /*
+         * Jump between deadlines until the next record.
+         * Expired deadline is processed in next millisecond, as with periodic processing
+         */
+        while (lwbtn_get_next_deadline(lwobj, now, &deadline) == LWBTN_DEADLINE_PENDING) {
+            if (deadline == now) {
+                ++deadline;
+            }
+            if (!prv_time_after(time, deadline)) {
+                break;
+            }
+            now = deadline;
+            lwbtn_process_ex(lwobj, now);
+        }
+
+        /* Apply all input changes at the same time */
+        do {
+            if (rec.type == LWBTN_TRACE_REC_INPUT && rec.btn_idx < lwobj->btns_cnt) {
+                lwbtn_word_t mask = (lwbtn_word_t)1 << (rec.btn_idx % LWBTN_WORD_BITS);
+
+                if (rec.val) {
+                    states[rec.btn_idx / LWBTN_WORD_BITS] |= mask;
+                } else {
+                    states[rec.btn_idx / LWBTN_WORD_BITS] &= ~mask;
+                }
+#if LWBTN_CFG_USE_ACTIVE_SET
+                lwbtn_notify_btn_change(lwobj, &lwobj->btns[rec.btn_idx]);
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+            }
+            has_rec = lwbtn_trace_read(data, len, &pos, &rec);
+        } while (has_rec && rec.time == time);
+        now = time;
+        lwbtn_process_ex(lwobj, now);
+    }
+    lwobj->replay_states = NULL;
+    return pos == len;
+}
+
+#endif /* LWBTN_CFG_USE_TRACE || __DOXYGEN__ */
+
+#if (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__
+
+/**
+ * \brief           Set dynamic parameters array of the group, when \ref LWBTN_CFG_USE_COMPACT is enabled
+ *
+ * All entries are set to default values from the configuration.
+ * Application can then modify parameters of each button, entry `n` belongs to button `n` of the group.
+ *
+ * \note            Function shall be called after \ref lwbtn_init_ex
+ *
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       params: Parameters array with one entry per button.
+ *                      Set to `NULL` to use default values for all buttons
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_params_init(lwbtn_t* lwobj, lwbtn_btn_params_t* params) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    for (size_t i = 0; params != NULL && i < lwobj->btns_cnt; ++i) {
+#if LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC
+        params[i].time_debounce = LWBTN_CFG_TIME_DEBOUNCE_PRESS;
+#endif /* LWBTN_CFG_TIME_DEBOUNCE_PRESS_DYNAMIC */
+#if LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC
+        params[i].time_debounce_release = LWBTN_CFG_TIME_DEBOUNCE_RELEASE;
+#endif /* LWBTN_CFG_TIME_DEBOUNCE_RELEASE_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC
+        params[i].time_click_pressed_min = LWBTN_CFG_TIME_CLICK_MIN;
+#endif /* LWBTN_CFG_TIME_CLICK_MIN_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC
+        params[i].time_click_pressed_max = LWBTN_CFG_TIME_CLICK_MAX;
+#endif /* LWBTN_CFG_TIME_CLICK_MAX_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC
+        params[i].time_click_multi_max = LWBTN_CFG_TIME_CLICK_MULTI_MAX;
+#endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC */
+#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC
+        params[i].time_keepalive_period = LWBTN_CFG_TIME_KEEPALIVE_PERIOD;
+#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC */
+#if LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC
+        params[i].max_consecutive = LWBTN_CFG_CLICK_MAX_CONSECUTIVE;
+#endif /* LWBTN_CFG_CLICK_MAX_CONSECUTIVE_DYNAMIC */
+    }
+    lwobj->params = params;
+    return 1;
+}
+
+#endif /* (LWBTN_CFG_USE_COMPACT && LWBTN_PARAMS_DYNAMIC) || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_PROFILES || __DOXYGEN__
+
+/**
+ * \brief           Set timing profiles table of the group
+ *
+ * Table is only referenced, application can change profile values at any time,
+ * and change applies to all buttons using the profile.
+ * Buttons use profile with index `0` by default.
+ *
+ * \note            Function shall be called after \ref lwbtn_init_ex.
+ *                      Profile index of every button must be lower than number of profiles
+ *
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       profiles: Profiles table. Set to `NULL` to use default profile for all buttons
+ * \param[in]       profiles_cnt: Number of profiles in the table
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_profiles_init(lwbtn_t* lwobj, const lwbtn_profile_t* profiles, uint8_t profiles_cnt) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (profiles == NULL) {
+        profiles = &lwbtn_profile_default;
+        profiles_cnt = 1;
+    } else if (profiles_cnt == 0) {
+        return 0;
+    }
+    lwobj->profiles = profiles;
+    lwobj->profiles_cnt = profiles_cnt;
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_PROFILES || __DOXYGEN__ */
+
+#if (LWBTN_CFG_USE_PROFILES && !LWBTN_CFG_USE_DESCRIPTORS) || __DOXYGEN__
+
+/**
+ * \brief           Set timing profile of the button
+ * \note            Not available with \ref LWBTN_CFG_USE_DESCRIPTORS, where profile is part of the descriptor
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button instance
+ * \param[in]       profile: Profile index in the table of the group
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_set_btn_profile(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t profile) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (btn == NULL || profile >= lwobj->profiles_cnt) {
+        return 0;
+    }
+    btn->profile = profile;
+    return 1;
+}
+
+#endif /* (LWBTN_CFG_USE_PROFILES && !LWBTN_CFG_USE_DESCRIPTORS) || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__
+
+/**
+ * \brief           Set constant descriptors array of the group
+ *
+ * Array is only referenced and must have one entry for every button of the group.
+ * Buttons use default descriptor, with all features enabled, until array is set.
+ *
+ * \note            Function shall be called after \ref lwbtn_init_ex.
+ *                      Profile index of every descriptor must be lower than number of profiles of the group
+ *
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       descs: Descriptors array. Set to `NULL` to use default descriptor for all buttons
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_descs_init(lwbtn_t* lwobj, const lwbtn_btn_desc_t* descs) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    lwobj->descs = descs;
+    return 1;
+}
+
+/**
+ * \brief           Get constant descriptor of the button
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button instance from the group
+ * \return          Button descriptor
+ */
+const lwbtn_btn_desc_t*
+lwbtn_get_btn_desc(lwbtn_t* lwobj, const lwbtn_btn_t* btn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    return LWBTN_BTN_DESC(lwobj, btn);
+}
+
+#endif /* LWBTN_CFG_USE_DESCRIPTORS || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Enable input edge queue of the group
+ *
+ * \note            Function shall be called after \ref lwbtn_init_ex, before processing starts
+ *
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       edges: Records array. Set to `NULL` to disable the queue
+ * \param[in]       size: Number of records in array. Must be power of `2`, between `2` and `32768`
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_edge_queue_init(lwbtn_t* lwobj, lwbtn_edge_t* edges, uint16_t size) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (edges != NULL && (size < 2 || size > 0x8000 || (size & (size - 1U)) != 0)) {
+        return 0;
+    }
+    LWBTN_MEMSET(&lwobj->edge_queue, 0x00, sizeof(lwobj->edge_queue));
+    lwobj->edge_queue.size = size;
+    lwobj->edge_queue.edges = edges;
+    return 1;
+}
+
+/**
+ * \brief           Write input edge of the button to the edge queue
+ *
+ * Function is intended to be called from GPIO edge interrupt, with time of the edge.
+ * Edge is replayed with its exact time by next processing call, that has time equal or later than the edge.
+ * After first edge, button takes its input state from the edges only.
+ *
+ * \note            Function must only be called from one context at a time,
+ *                      for example from interrupts of the same priority
+ *
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       btn: Button instance from the group
+ * \param[in]       state: New input state, `1` when button is considered `active`, `0` otherwise
+ * \param[in]       mstime: Time of the edge in milliseconds
+ * \return          `1` on success, `0` when queue is full or not enabled
+ */
+uint8_t
+lwbtn_push_edge(lwbtn_t* lwobj, lwbtn_btn_t* btn, uint8_t state, lwbtn_time_t mstime) {
+    lwbtn_edge_queue_t* queue;
+    lwbtn_edge_t* edge;
+    uint16_t w;
+
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+    queue = &lwobj->edge_queue;
+    if (queue->edges == NULL || btn < lwobj->btns || btn >= &lwobj->btns[lwobj->btns_cnt]) {
+        return 0;
+    }
+    w = queue->w;
+    if ((uint16_t)(w - queue->r) >= queue->size) {
+        ++queue->dropped;
+        return 0;
+    }
+    edge = &queue->edges[w & (queue->size - 1U)];
+    edge->time = mstime;
+    edge->btn_idx = (uint16_t)(btn - lwobj->btns);
+    edge->state = state ? 1 : 0;
+    LWBTN_MEMORY_BARRIER(); /* Record must be written before index is updated */
+    queue->w = (uint16_t)(w + 1U);
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_TIMER || __DOXYGEN__
+
+/**
+ * \brief           Set timer function of the group, for event driven processing
+ *
+ * Function is called after processing, whenever next deadline of the group changes.
+ * Application arms one-shot timer and calls processing function when timer expires,
+ * or when input edge is detected. Timer must not expire before the requested time.
+ *
+ * \note            Function shall be called after \ref lwbtn_init_ex
+ *
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       set_timer_fn: Set timer function. Set to `NULL` to disable the calls
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_timer_init(lwbtn_t* lwobj, lwbtn_set_timer_fn set_timer_fn) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    lwobj->set_timer_fn = set_timer_fn;
+    lwobj->timer_status = (uint8_t)LWBTN_DEADLINE_IDLE;
+    lwobj->timer_time = 0;
+    lwobj->timer_mstime = 0;
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_TIMER || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__
+
+/**
+ * \brief           Enable timing wheel of pending button deadlines for the group
+ *
+ * Buttons, that wait for a timeout, are linked to wheel slot of their deadline, instead of being kept in active set.
+ * Processing only checks slots, that have passed since previous processing,
+ * and processes buttons with expired deadline and buttons notified with \ref lwbtn_notify_btn_change.
+ *
+ * Deadline farther than number of slots is kept in the wheel for more turns,
+ * slots count shall therefore cover the longest timeout for best efficiency.
+ *
+ * \note            Function shall be called after \ref lwbtn_active_set_init.
+ *                      All buttons are put back to active set, to be processed with next processing call
+ * \note            After timing parameters of the button are changed,
+ *                      \ref lwbtn_notify_btn_change shall be called for its deadline to be updated
+ *
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       slots: Slots array, with `slots_cnt` entries. Set to `NULL` to disable the wheel
+ * \param[in]       slots_cnt: Number of slots, one per millisecond. Must be power of `2`, between `2` and `32768`
+ * \param[in]       nodes: Wheel entries array, with one entry per button of the group
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_wheel_init(lwbtn_t* lwobj, uint16_t* slots, uint16_t slots_cnt, lwbtn_wheel_node_t* nodes) {
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+
+    if (lwobj->active == NULL
+        || (slots != NULL
+            && (nodes == NULL || slots_cnt < 2 || slots_cnt > 0x8000 || (slots_cnt & (slots_cnt - 1U)) != 0
+                || lwobj->btns_cnt >= LWBTN_WHEEL_UNLINKED))) {
+        return 0;
+    }
+    if (slots != NULL) {
+        for (size_t idx = 0; idx < slots_cnt; ++idx) {
+            slots[idx] = LWBTN_WHEEL_NONE;
+        }
+        for (size_t idx = 0; idx < lwobj->btns_cnt; ++idx) {
+            nodes[idx].next = LWBTN_WHEEL_NONE;
+            nodes[idx].prev = LWBTN_WHEEL_UNLINKED;
+        }
+    }
+    lwobj->wheel.slots = slots;
+    lwobj->wheel.nodes = nodes;
+    lwobj->wheel.slots_cnt = slots_cnt;
+    lwobj->wheel.time = 0;
+
+    /* Buttons, that were waiting in the wheel, are processed again */
+    for (size_t w_idx = 0; w_idx < LWBTN_BITMAP_WORDS(lwobj->btns_cnt); ++w_idx) {
+        LWBTN_SHARED_OR(&lwobj->active[w_idx], prv_bitmap_word_mask(lwobj->btns_cnt, w_idx));
+    }
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_TIMING_WHEEL || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_BITSLICE || __DOXYGEN__
+
+/* Maximum value of vertical counter */
+#define LWBTN_BS_CNT_MAX ((1UL << LWBTN_CFG_BITSLICE_CNT_BITS) - 1U)
+
+/* Per-button period arrays, or NULL when fixed period is used */
+#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC
+#define LWBTN_BS_KEEPALIVE_PERIODS(blk) ((blk)->keepalive_period)
+#else
+#define LWBTN_BS_KEEPALIVE_PERIODS(blk) NULL
+#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC
+#define LWBTN_BS_CLICK_PERIODS(blk) ((blk)->click_period)
+#else
+#define LWBTN_BS_CLICK_PERIODS(blk) NULL
+#endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC */
+
+/**
+ * \brief           Get mask of buttons whose vertical counter is greater or equal to the value
+ * \param[in]       blk: Bit-sliced block
+ * \param[in]       val: Value to compare against
+ * \return          Bit mask of buttons with counter `>= val`
+ */
+static lwbtn_word_t
+prv_bs_cnt_ge(const lwbtn_bs_block_t* blk, uint8_t val) {
+    lwbtn_word_t gt = 0, eq = ~(lwbtn_word_t)0;
+
+    /* Compare from most significant plane down */
+    for (size_t i = LWBTN_CFG_BITSLICE_CNT_BITS; i > 0; --i) {
+        if (val & (1U << (i - 1))) {
+            eq &= blk->cnt[i - 1];
+        } else {
+            gt |= eq & blk->cnt[i - 1];
+            eq &= ~blk->cnt[i - 1];
+        }
+    }
+    return gt | eq;
+}
+
+#if LWBTN_CFG_USE_KEEPALIVE || LWBTN_CFG_USE_CLICK
+
+/**
+ * \brief           Get mask of buttons in a block, for which period has elapsed since their base time
+ * 
+ * Compares all \ref LWBTN_BS_BLOCK_BTNS entries at once, using SIMD instructions when available.
+ * Number of buttons in a block is always multiple of vector width.
  * 
- * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
- * \param[in]       btn: Button object. Must not be set to `NULL`
+ * \param[in]       base: Array of base times, one per button in the block
+ * \param[in]       period: Array of periods, one per button in the block.
+ *                      Set to `NULL` to use `period_fix` for all buttons
+ * \param[in]       period_fix: Period for all buttons, when `period` is `NULL`
  * \param[in]       mstime: Current system time in milliseconds
+ * \return          Bit mask of buttons with `mstime - base >= period`
+ */
+static lwbtn_word_t
+prv_bs_elapsed(const lwbtn_time_t* base, const lwbtn_time_t* period, lwbtn_time_t period_fix, lwbtn_time_t mstime) {
+    lwbtn_word_t mask = 0;
+
+#if LWBTN_BS_USE_AVX2
+    if (sizeof(lwbtn_time_t) == 4) {
+        /* Unsigned compare is done as signed one, with sign bit flipped */
+        const __m256i sign = _mm256_set1_epi32((int)0x80000000UL);
+        const __m256i now = _mm256_set1_epi32((int)mstime);
+        __m256i per = _mm256_xor_si256(_mm256_set1_epi32((int)period_fix), sign);
+
+        for (size_t i = 0; i < LWBTN_BS_BLOCK_BTNS; i += 8) {
+            __m256i diff = _mm256_sub_epi32(now, _mm256_loadu_si256((const __m256i*)(const void*)&base[i]));
+            if (period != NULL) {
+                per = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(const void*)&period[i]), sign);
+            }
+            /* Period greater than elapsed time means button is not due yet */
+            unsigned m = (unsigned)_mm256_movemask_ps(
+                _mm256_castsi256_ps(_mm256_cmpgt_epi32(per, _mm256_xor_si256(diff, sign))));
+            mask |= (lwbtn_word_t)(~m & 0xFFU) << i;
+        }
+        return mask;
+    }
+#endif /* LWBTN_BS_USE_AVX2 */
+#if LWBTN_BS_USE_SSE2
+    if (sizeof(lwbtn_time_t) == 4) {
+        const __m128i sign = _mm_set1_epi32((int)0x80000000UL);
+        const __m128i now = _mm_set1_epi32((int)mstime);
+        __m128i per = _mm_xor_si128(_mm_set1_epi32((int)period_fix), sign);
+
+        for (size_t i = 0; i < LWBTN_BS_BLOCK_BTNS; i += 4) {
+            __m128i diff = _mm_sub_epi32(now, _mm_loadu_si128((const __m128i*)(const void*)&base[i]));
+            if (period != NULL) {
+                per = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)&period[i]), sign);
+            }
+            unsigned m = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(per, _mm_xor_si128(diff, sign))));
+            mask |= (lwbtn_word_t)(~m & 0x0FU) << i;
+        }
+        return mask;
+    } else if (sizeof(lwbtn_time_t) == 2) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i now = _mm_set1_epi16((short)mstime);
+        __m128i per = _mm_set1_epi16((short)period_fix);
+
+        for (size_t i = 0; i < LWBTN_BS_BLOCK_BTNS; i += 8) {
+            __m128i diff = _mm_sub_epi16(now, _mm_loadu_si128((const __m128i*)(const void*)&base[i]));
+            if (period != NULL) {
+                per = _mm_loadu_si128((const __m128i*)(const void*)&period[i]);
+            }
+            /* Saturated subtraction is zero when period is lower or equal to elapsed time */
+            __m128i ge = _mm_cmpeq_epi16(_mm_subs_epu16(per, diff), zero);
+            mask |= (lwbtn_word_t)((unsigned)_mm_movemask_epi8(_mm_packs_epi16(ge, zero)) & 0xFFU) << i;
+        }
+        return mask;
+    }
+#endif /* LWBTN_BS_USE_SSE2 */
+
+    /* Portable implementation */
+    for (size_t i = 0; i < LWBTN_BS_BLOCK_BTNS; ++i) {
+        lwbtn_time_t per = period != NULL ? period[i] : period_fix;
+        mask |= (lwbtn_word_t)((lwbtn_time_t)(mstime - base[i]) >= per) << i;
+    }
+    return mask;
+}
+
+#endif /* LWBTN_CFG_USE_KEEPALIVE || LWBTN_CFG_USE_CLICK */
+
+/**
+ * \brief           Initialize bit-sliced button group
+ * 
+ * \note            Debounce times are converted to number of processing calls,
+ *                  using \ref LWBTN_CFG_TIME_DEBOUNCE_PRESS and \ref LWBTN_CFG_TIME_DEBOUNCE_RELEASE.
+ *                  Per-button dynamic debounce times cannot be used with bit-sliced group.
+ *                  All other (click and keep alive) parameters are used as in regular group.
+ * 
+ * \param[in]       lwbs: Bit-sliced LwBTN instance
+ * \param[in]       btns: Array of buttons to process
+ * \param[in]       btns_cnt: Number of buttons to process
+ * \param[in]       blocks: Array of blocks, with at least \ref LWBTN_BS_BLOCKS_CNT `(btns_cnt)` entries
+ * \param[in]       period: Period in milliseconds at which \ref lwbtn_bs_process is called. Must be greater than `0`
+ * \param[in]       get_input_fn: Pointer to function providing block input states on demand.
+ *                      Set to `NULL` to set the states with \ref lwbtn_bs_set_input function
+ * \param[in]       evt_fn: Button event function callback.
+ *                      May be set to `NULL` when events are read from the queue of \ref lwbtn_bs_t::lw group
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
-lwbtn_process_btn_ex(lwbtn_t* lwobj, lwbtn_btn_t* btn, lwbtn_time_t mstime) {
-    if (btn != NULL) {
-        prv_process_btn(LWBTN_GET_LWOBJ(lwobj), btn, mstime);
-        return 1;
+lwbtn_bs_init(lwbtn_bs_t* lwbs, lwbtn_btn_t* btns, uint16_t btns_cnt, lwbtn_bs_block_t* blocks, lwbtn_time_t period,
+              lwbtn_bs_get_input_fn get_input_fn, lwbtn_evt_fn evt_fn) {
+    uint32_t cnt_press, cnt_release;
+
+    if (lwbs == NULL || btns == NULL || btns_cnt == 0 || blocks == NULL || period == 0
+#if !LWBTN_CFG_USE_EVT_QUEUE
+        || evt_fn == NULL
+#endif /* !LWBTN_CFG_USE_EVT_QUEUE */
+    ) {
+        return 0;
     }
-    return 0;
+
+    /* Debounce in units of processing calls. At least one call is always required, as in regular group */
+    cnt_press = ((uint32_t)LWBTN_CFG_TIME_DEBOUNCE_PRESS + period - 1U) / period;
+    cnt_release = ((uint32_t)LWBTN_CFG_TIME_DEBOUNCE_RELEASE + period - 1U) / period;
+    cnt_press = cnt_press > 0 ? cnt_press : 1;
+    cnt_release = cnt_release > 0 ? cnt_release : 1;
+    if (cnt_press > LWBTN_BS_CNT_MAX || cnt_release > LWBTN_BS_CNT_MAX) {
+        return 0;
+    }
+
+    LWBTN_MEMSET(lwbs, 0x00, sizeof(*lwbs));
+    lwbs->lw.btns = btns;
+    lwbs->lw.btns_cnt = btns_cnt;
+    lwbs->lw.evt_fn = evt_fn;
+    lwbs->blocks = blocks;
+    lwbs->blocks_cnt = (uint16_t)LWBTN_BS_BLOCKS_CNT(btns_cnt);
+    lwbs->get_input_fn = get_input_fn;
+    lwbs->cnt_press = (uint8_t)cnt_press;
+    lwbs->cnt_release = (uint8_t)cnt_release;
+    LWBTN_MEMSET(blocks, 0x00, sizeof(*blocks) * lwbs->blocks_cnt);
+    prv_btns_set_defaults(btns, btns_cnt);
+    return 1;
 }
 
 /**
- * \brief           Set button state to either "active" or "inactive".
- * \param[in]       btn: Button instance
- * \param[in]       state: New button state. `1` is for active (pressed), `0` is for inactive (released).
+ * \brief           Bit-sliced group processing function.
+ * 
+ * It processes whole block of buttons with logical operations, and calls per-button
+ * processing only for buttons with valid press, valid release, due keep alive or click timeout.
+ * Button structure is only accessed when event is about to be sent.
+ * Events are sent in the same order and with the same semantics as \ref lwbtn_process_ex,
+ * when function is called at period, configured with \ref lwbtn_bs_init.
+ * 
+ * \param[in]       lwbs: Bit-sliced LwBTN instance
+ * \param[in]       mstime: Current system time in milliseconds
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
-lwbtn_set_btn_state(lwbtn_btn_t* btn, uint8_t state) {
-#if LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK
-    btn->curr_state = state;
-    btn->flags |= LWBTN_FLAG_MANUAL_STATE;
+lwbtn_bs_process(lwbtn_bs_t* lwbs, lwbtn_time_t mstime) {
+    lwbtn_t* lwobj;
+    uint8_t cnt_max;
+
+    if (lwbs == NULL) {
+        return 0;
+    }
+    lwobj = &lwbs->lw;
+    cnt_max = lwbs->cnt_press > lwbs->cnt_release ? lwbs->cnt_press : lwbs->cnt_release;
+
+    for (uint16_t b_idx = 0; b_idx < lwbs->blocks_cnt; ++b_idx) {
+        lwbtn_bs_block_t* blk = &lwbs->blocks[b_idx];
+        size_t base = (size_t)b_idx * LWBTN_BS_BLOCK_BTNS;
+        lwbtn_word_t valid, raw, skip, rst, act, chg, stable, carry, press, release, hold = 0, pending = 0, evt;
+
+        /* Mask of buttons that exist in this block */
+        valid = (lwobj->btns_cnt - base) >= LWBTN_BS_BLOCK_BTNS ? ~(lwbtn_word_t)0
+                                                                 : (((lwbtn_word_t)1 << (lwobj->btns_cnt - base)) - 1U);
+        raw = (lwbs->get_input_fn != NULL ? lwbs->get_input_fn(lwbs, b_idx) : blk->input) & valid;
+
+        /*
+         * First state must be "inactive" before any further processing.
+         * Active buttons, not ready yet, are skipped completely,
+         * inactive ones get reset to default state.
+         */
+        skip = ~blk->ready & raw;
+        rst = ~blk->ready & ~raw & valid;
+        for (lwbtn_word_t m = rst; m != 0; m &= m - 1U) {
+            lwobj->btns[base + prv_ctz(m)].flags = LWBTN_FLAG_FIRST_INACTIVE_RCVD;
+        }
+        blk->last &= ~rst;
+        blk->sent &= ~rst;
+        blk->ready |= rst;
+        act = valid & ~skip;
+
+        /* Vertical counter: reset on input change, increment otherwise until saturated */
+        chg = (raw ^ blk->last) & act;
+        carry = act & ~chg & ~prv_bs_cnt_ge(blk, cnt_max);
+        for (size_t i = 0; i < LWBTN_CFG_BITSLICE_CNT_BITS; ++i) {
+            lwbtn_word_t next_carry = blk->cnt[i] & carry;
+            blk->cnt[i] = (blk->cnt[i] ^ carry) & ~chg;
+            carry = next_carry;
+        }
+        blk->last = (blk->last & ~act) | (raw & act);
+
+        /* Buttons that need per-button processing */
+        stable = act & ~chg;
+        press = stable & raw & ~blk->sent & prv_bs_cnt_ge(blk, lwbs->cnt_press);
+        release = stable & ~raw & blk->sent & prv_bs_cnt_ge(blk, lwbs->cnt_release);
+#if LWBTN_CFG_USE_KEEPALIVE
+        hold = stable & raw & blk->sent;
+        if (hold != 0) {
+            hold &= prv_bs_elapsed(blk->keepalive_time, LWBTN_BS_KEEPALIVE_PERIODS(blk),
+                                   (lwbtn_time_t)LWBTN_CFG_TIME_KEEPALIVE_PERIOD, mstime);
+        }
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+        pending = stable & ~raw & ~blk->sent & blk->click;
+        if (pending != 0) {
+            pending &= prv_bs_elapsed(blk->click_time, LWBTN_BS_CLICK_PERIODS(blk),
+                                      (lwbtn_time_t)LWBTN_CFG_TIME_CLICK_MULTI_MAX, mstime);
+        }
+#endif /* LWBTN_CFG_USE_CLICK */
+        blk->sent = (blk->sent | press) & ~release;
+
+        evt = press | release | hold | pending;
+        while (evt != 0) {
+            uint8_t bit = prv_ctz(evt);
+            lwbtn_word_t mask = (lwbtn_word_t)1 << bit;
+            lwbtn_btn_t* btn = &lwobj->btns[base + bit];
+
+            evt &= evt - 1U;
+            if (press & mask) {
+                prv_btn_onpress(lwobj, btn, mstime);
+            } else if (release & mask) {
+                prv_btn_onrelease(lwobj, btn, mstime);
+#if LWBTN_CFG_USE_KEEPALIVE
+            } else if (hold & mask) {
+                prv_btn_keepalive(lwobj, btn, mstime);
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+            } else if (pending & mask) {
+                prv_btn_click_timeout(lwobj, btn, mstime);
+#endif /* LWBTN_CFG_USE_CLICK */
+            }
+
+            /* Mirror timing of the button to block arrays */
+#if LWBTN_CFG_USE_KEEPALIVE
+            blk->keepalive_time[bit] = btn->keepalive.last_time;
+#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC
+            blk->keepalive_period[bit] = LWBTN_TIME_KEEPALIVE_PERIOD(lwobj, btn);
+#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC */
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+            blk->click = btn->click.cnt > 0 ? (blk->click | mask) : (blk->click & ~mask);
+            blk->click_time[bit] = btn->click.last_time;
+#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC
+            blk->click_period[bit] = LWBTN_TIME_CLICK_MAX_MULTI(lwobj, btn);
+#endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC */
+#endif /* LWBTN_CFG_USE_CLICK */
+        }
+    }
     return 1;
-#else  /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK */
-    (void)btn;
-    (void)state;
-    return 0;
-#endif /* LWBTN_CFG_GET_STATE_MODE != LWBTN_GET_STATE_MODE_CALLBACK */
 }
 
 /**
- * \brief           Check if button is active.
- * Active is considered when initial debounce period has been a pass.
- * This is the period between on-press and on-release events.
+ * \brief           Set input states for one block of bit-sliced group
  * 
- * \param[in]       btn: Button handle to check
- * \return          `1` if active, `0` otherwise
+ * Used when group has no get input function.
+ * 
+ * \param[in]       lwbs: Bit-sliced LwBTN instance
+ * \param[in]       block_idx: Block index. Button with index `i` is in block `i / LWBTN_BS_BLOCK_BTNS`
+ * \param[in]       input: Bit mask of input states, bit set to `1` when button is considered `active`
+ * \return          `1` on success, `0` otherwise
  */
 uint8_t
-lwbtn_is_btn_active(const lwbtn_btn_t* btn) {
-    return btn != NULL && (btn->flags & LWBTN_FLAG_ONPRESS_SENT);
+lwbtn_bs_set_input(lwbtn_bs_t* lwbs, uint16_t block_idx, lwbtn_word_t input) {
+    if (lwbs == NULL || block_idx >= lwbs->blocks_cnt) {
+        return 0;
+    }
+    lwbs->blocks[block_idx].input = input;
+    return 1;
 }
 
 /**
- * \brief           Reset button[s] state to default
+ * \brief           Reset button[s] state of the bit-sliced group to default
  * 
- *                  When reset is called, and if button is pressed (active),
- *                  no further events will be called up until we receive
- *                  the new valid press action.
+ * Function behaves the same way as \ref lwbtn_reset for regular group.
  * 
- *                  A typical use case would be when application needs to react
- *                  on a long press (several keep alive events).
- *                  
- *                  Consider the use case where user runs the GUI and long press changes the screen.
- *                  The new screen has its own button handling method, which performs some other action (eg. "go home" action).
- *                  
- *                  Calling the reset function will prevent new screen to continue receiving the events
- *                  and forces the user to release the button and press it again.
+ * \param[in]       lwbs: Bit-sliced LwBTN instance
+ * \param[in]       btn: Button object to reset. Set to `NULL` to reset all buttons in the group
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_bs_reset(lwbtn_bs_t* lwbs, lwbtn_btn_t* btn) {
+    size_t idx;
+
+    if (lwbs == NULL) {
+        return 0;
+    }
+    if (btn == NULL) {
+        for (idx = 0; idx < lwbs->blocks_cnt; ++idx) {
+            lwbs->blocks[idx].ready = 0;
+        }
+        return 1;
+    }
+    if (btn < lwbs->lw.btns || btn >= &lwbs->lw.btns[lwbs->lw.btns_cnt]) {
+        return 0;
+    }
+    idx = (size_t)(btn - lwbs->lw.btns);
+    lwbs->blocks[idx / LWBTN_BS_BLOCK_BTNS].ready &= ~((lwbtn_word_t)1 << (idx % LWBTN_BS_BLOCK_BTNS));
+    btn->flags &= ~LWBTN_FLAG_FIRST_INACTIVE_RCVD;
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_BITSLICE || __DOXYGEN__ */
+
+#if LWBTN_CFG_USE_PARALLEL || __DOXYGEN__
+
+/* Cache line size in bytes, shard boundaries are aligned to it */
+#define LWBTN_PAR_CACHE_LINE 64U
+
+/* Number of shards per thread, for load balancing between workers */
+#define LWBTN_PAR_SHARDS_PER_THREAD 8U
+
+/**
+ * \brief           Claim and process shards, until all shards of current round are taken
+ * \note            Mutex must be locked when function is called, and is locked on return
+ * \param[in]       lwpar: Parallel processing instance
+ */
+static void
+prv_par_run(lwbtn_par_t* lwpar) {
+    lwbtn_t* lwobj = lwpar->lwobj;
+
+    while (lwpar->shard_next < lwpar->shards_cnt) {
+        uint16_t shard_idx = lwpar->shard_next++;
+        size_t start = (size_t)shard_idx * lwpar->shard_btns;
+        size_t end = start + lwpar->shard_btns < lwobj->btns_cnt ? start + lwpar->shard_btns : lwobj->btns_cnt;
+
+        pthread_mutex_unlock(&lwpar->mutex);
+        lwpar->shards[shard_idx].evts_cnt = 0;
+        prv_process_range(lwobj, start, end, lwpar->mstime);
+        pthread_mutex_lock(&lwpar->mutex);
+    }
+}
+
+/**
+ * \brief           Worker thread
+ * \param[in]       arg: Parallel processing instance
+ * \return          `NULL`
+ */
+static void*
+prv_par_worker(void* arg) {
+    lwbtn_par_t* lwpar = arg;
+    uint32_t round = 0; /* Rounds start after workers are created, first round may already be running */
+
+    pthread_mutex_lock(&lwpar->mutex);
+    for (;;) {
+        while (!lwpar->stop && lwpar->round == round) {
+            pthread_cond_wait(&lwpar->cond_start, &lwpar->mutex);
+        }
+        if (lwpar->stop) {
+            break;
+        }
+        round = lwpar->round;
+        prv_par_run(lwpar);
+        if (--lwpar->workers_busy == 0) {
+            pthread_cond_signal(&lwpar->cond_done);
+        }
+    }
+    pthread_mutex_unlock(&lwpar->mutex);
+    return NULL;
+}
+
+/**
+ * \brief           Stop workers and free resources of partially or fully initialized instance
+ * \param[in]       lwpar: Parallel processing instance
+ * \param[in]       workers_cnt: Number of running worker threads
+ */
+static void
+prv_par_cleanup(lwbtn_par_t* lwpar, uint16_t workers_cnt) {
+    pthread_mutex_lock(&lwpar->mutex);
+    lwpar->stop = 1;
+    pthread_cond_broadcast(&lwpar->cond_start);
+    pthread_mutex_unlock(&lwpar->mutex);
+    for (uint16_t i = 0; i < workers_cnt; ++i) {
+        pthread_join(lwpar->workers[i], NULL);
+    }
+    for (uint16_t i = 0; lwpar->shards != NULL && i < lwpar->shards_cnt; ++i) {
+        free(lwpar->shards[i].evts);
+    }
+    free(lwpar->shards);
+    free(lwpar->workers);
+    pthread_cond_destroy(&lwpar->cond_done);
+    pthread_cond_destroy(&lwpar->cond_start);
+    pthread_mutex_destroy(&lwpar->mutex);
+    LWBTN_MEMSET(lwpar, 0x00, sizeof(*lwpar));
+}
+
+/**
+ * \brief           Initialize parallel processing of the group and start worker threads
  * 
- * \note            If button is reset during active time, there will be no further events
- *                  for this button sent to the application, up until a new valid on-press is detected
+ * Buttons array is split into shards. Shard size is multiple of the cache line,
+ * to avoid false sharing between workers (buttons array shall be aligned to cache line),
+ * and multiple of \ref LWBTN_WORD_BITS, so that active set words are not shared between shards either.
  * 
- * \param           lwobj: Object to reset buttons. Set to non-NULL to reset
- *                      all buttons in an object
- * \param           btn: Button object to reset. Optional parameter.
- *                      When non-NULL, button is reset
+ * \note            Group must be initialized before, and must not be processed
+ *                  with \ref lwbtn_process_ex while parallel instance is used
+ * 
+ * \param[in]       lwpar: Parallel processing instance
+ * \param[in]       lwobj: LwBTN instance. Set to `NULL` to use default one
+ * \param[in]       workers_cnt: Number of worker threads to create.
+ *                      Thread calling \ref lwbtn_par_process takes part in processing too
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
-lwbtn_reset(lwbtn_t* lwobj, lwbtn_btn_t* btn) {
-    for (size_t idx = 0; idx < (lwobj != NULL ? lwobj->btns_cnt : 0); ++idx) {
-        lwobj->btns[idx].flags &= ~LWBTN_FLAG_FIRST_INACTIVE_RCVD;
+lwbtn_par_init(lwbtn_par_t* lwpar, lwbtn_t* lwobj, uint16_t workers_cnt) {
+    size_t btn_size = sizeof(lwbtn_btn_t), unit, shard_btns;
+    uint16_t created = 0;
+
+    lwobj = LWBTN_GET_LWOBJ(lwobj);
+    if (lwpar == NULL || lwobj->btns == NULL || lwobj->btns_cnt == 0) {
+        return 0;
     }
-    if (btn != NULL) {
-        btn->flags &= ~LWBTN_FLAG_FIRST_INACTIVE_RCVD;
+    LWBTN_MEMSET(lwpar, 0x00, sizeof(*lwpar));
+
+    /* Smallest number of buttons covering whole cache lines and whole active set words */
+    btn_size &= ~btn_size + 1U;
+    unit = btn_size >= LWBTN_PAR_CACHE_LINE ? 1U : LWBTN_PAR_CACHE_LINE / btn_size;
+    unit = unit > LWBTN_WORD_BITS ? unit : LWBTN_WORD_BITS;
+    shard_btns = lwobj->btns_cnt / (((size_t)workers_cnt + 1U) * LWBTN_PAR_SHARDS_PER_THREAD);
+    shard_btns = shard_btns > unit ? ((shard_btns + unit - 1U) / unit) * unit : unit;
+
+    lwpar->lwobj = lwobj;
+    lwpar->shard_btns = (uint16_t)(shard_btns < lwobj->btns_cnt ? shard_btns : lwobj->btns_cnt);
+    lwpar->shards_cnt = (uint16_t)((lwobj->btns_cnt + lwpar->shard_btns - 1U) / lwpar->shard_btns);
+    lwpar->workers_cnt = workers_cnt;
+    pthread_mutex_init(&lwpar->mutex, NULL);
+    pthread_cond_init(&lwpar->cond_start, NULL);
+    pthread_cond_init(&lwpar->cond_done, NULL);
+
+    lwpar->shards = calloc(lwpar->shards_cnt, sizeof(*lwpar->shards));
+    lwpar->workers = calloc(workers_cnt > 0 ? workers_cnt : 1U, sizeof(*lwpar->workers));
+    if (lwpar->shards == NULL || lwpar->workers == NULL) {
+        prv_par_cleanup(lwpar, 0);
+        return 0;
+    }
+    for (; created < workers_cnt; ++created) {
+        if (pthread_create(&lwpar->workers[created], NULL, prv_par_worker, lwpar) != 0) {
+            prv_par_cleanup(lwpar, created);
+            return 0;
+        }
     }
     return 1;
 }
+
+/**
+ * \brief           Process the group in parallel, with worker threads
+ * 
+ * Buttons are processed by all workers and calling thread at the same time.
+ * Events are buffered per shard, and are delivered from the calling thread
+ * after all shards are processed, in the same order as with \ref lwbtn_process_ex.
+ * During event function call, button flags, click and keep alive counters
+ * have the values from the time of event.
+ * 
+ * \note            Get state function is called from worker threads and must be thread-safe
+ * 
+ * \param[in]       lwpar: Parallel processing instance
+ * \param[in]       mstime: Current system time in milliseconds
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_par_process(lwbtn_par_t* lwpar, lwbtn_time_t mstime) {
+    lwbtn_t* lwobj;
+
+    if (lwpar == NULL || lwpar->lwobj == NULL || !prv_process_prepare(lwpar->lwobj)) {
+        return 0;
+    }
+    lwobj = lwpar->lwobj;
+#if LWBTN_CFG_USE_EDGE_QUEUE
+    /* Edges are replayed before workers start, events are sent directly */
+    if (lwobj->edge_queue.edges != NULL) {
+        prv_edge_queue_replay(lwobj, mstime);
+    }
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+
+    /* Start the round and take part in it */
+    pthread_mutex_lock(&lwpar->mutex);
+    lwpar->mstime = mstime;
+    lwpar->shard_next = 0;
+    lwpar->workers_busy = lwpar->workers_cnt;
+    ++lwpar->round;
+    lwobj->par = lwpar;
+    pthread_cond_broadcast(&lwpar->cond_start);
+    prv_par_run(lwpar);
+    while (lwpar->workers_busy > 0) {
+        pthread_cond_wait(&lwpar->cond_done, &lwpar->mutex);
+    }
+    lwobj->par = NULL;
+    pthread_mutex_unlock(&lwpar->mutex);
+#if LWBTN_CFG_USE_EDGE_QUEUE
+    lwobj->edge_queue.time_last = mstime;
+#endif /* LWBTN_CFG_USE_EDGE_QUEUE */
+
+    /* Deliver events in button order */
+    for (uint16_t shard_idx = 0; shard_idx < lwpar->shards_cnt; ++shard_idx) {
+        const lwbtn_par_shard_t* shard = &lwpar->shards[shard_idx];
+
+        for (size_t i = 0; i < shard->evts_cnt; ++i) {
+            const lwbtn_par_evt_t* rec = &shard->evts[i];
+
+            prv_send_evt_deferred(lwobj, &lwobj->btns[rec->btn_idx], (lwbtn_evt_t)rec->evt, rec->flags,
+                                  rec->keepalive_cnt, rec->click_cnt, mstime);
+        }
+    }
+#if LWBTN_CFG_USE_EVT_BATCH
+    prv_evt_batch_deliver(lwobj);
+#endif /* LWBTN_CFG_USE_EVT_BATCH */
+#if LWBTN_CFG_USE_TIMER
+    prv_timer_update(lwobj, mstime);
+#endif /* LWBTN_CFG_USE_TIMER */
+    return 1;
+}
+
+/**
+ * \brief           Stop worker threads and free resources of parallel processing instance
+ * \param[in]       lwpar: Parallel processing instance
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwbtn_par_deinit(lwbtn_par_t* lwpar) {
+    if (lwpar == NULL || lwpar->lwobj == NULL) {
+        return 0;
+    }
+    prv_par_cleanup(lwpar, lwpar->workers_cnt);
+    return 1;
+}
+
+#endif /* LWBTN_CFG_USE_PARALLEL || __DOXYGEN__ */
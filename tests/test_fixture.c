@@ -0,0 +1,140 @@
+#include "test_fixture.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t rand_seed = 0x12345678;
+
+/**
+ * \brief           Set seed of pseudo-random generator
+ * \param[in]       seed: New seed
+ */
+void
+test_rand_init(uint32_t seed) {
+    rand_seed = seed;
+}
+
+/**
+ * \brief           Simple deterministic pseudo-random generator
+ * \return          Random value between `0` and `0xFFFF`
+ */
+uint32_t
+test_rand(void) {
+    rand_seed = rand_seed * 1103515245U + 12345U;
+    return (rand_seed >> 8) & 0xFFFF;
+}
+
+/**
+ * \brief           Set initial inputs, some of them active to test first inactive state detection
+ * \param[out]      inputs: Inputs array
+ * \param[in]       cnt: Number of inputs
+ * \param[in]       remaining_max: Maximum time of initial state
+ */
+void
+test_inputs_init(btn_test_input_t* inputs, size_t cnt, uint32_t remaining_max) {
+    for (size_t i = 0; i < cnt; ++i) {
+        inputs[i].state = (i % 5) == 0;
+        inputs[i].remaining = test_rand() % remaining_max;
+    }
+}
+
+/**
+ * \brief           Advance simulated inputs for one millisecond, mixing bounces, clicks and long presses
+ * \param[in,out]   inputs: Inputs array
+ * \param[in]       cnt: Number of inputs
+ * \param[in]       long_max: Maximum time of long press or idle state
+ * \param[in]       edge_fn: Function called on every input edge. Can be `NULL`
+ * \return          `1` if any input changed, `0` otherwise
+ */
+uint8_t
+test_inputs_step(btn_test_input_t* inputs, size_t cnt, uint32_t long_max, btn_test_edge_fn edge_fn) {
+    uint8_t edge = 0;
+
+    for (size_t i = 0; i < cnt; ++i) {
+        if (inputs[i].remaining > 0) {
+            --inputs[i].remaining;
+            continue;
+        }
+        inputs[i].state = !inputs[i].state;
+        edge = 1;
+        if (edge_fn != NULL) {
+            edge_fn(i, inputs[i].state);
+        }
+        switch (test_rand() % 4) {
+            case 0: inputs[i].remaining = test_rand() % 15; break;        /* Bounce */
+            case 1: inputs[i].remaining = 20 + test_rand() % 300; break;  /* Click */
+            case 2: inputs[i].remaining = 100 + test_rand() % 500; break; /* Gap */
+            default: inputs[i].remaining = test_rand() % long_max; break; /* Long press or idle */
+        }
+    }
+    return edge;
+}
+
+/**
+ * \brief           Add event to the list
+ * \param[in,out]   evts: Events list
+ * \param[in]       time: Time of the event
+ * \param[in]       idx: Button index
+ * \param[in]       evt: Event type
+ * \return          Cleared record with time, index and event set, `NULL` if list is full
+ */
+btn_test_rec_t*
+test_evts_add(btn_test_evts_t* evts, uint32_t time, uint16_t idx, lwbtn_evt_t evt) {
+    btn_test_rec_t* rec;
+
+    if (evts->cnt >= evts->size) {
+        return NULL;
+    }
+    rec = &evts->recs[evts->cnt++];
+    memset(rec, 0x00, sizeof(*rec));
+    rec->time = time;
+    rec->idx = idx;
+    rec->evt = evt;
+    return rec;
+}
+
+/**
+ * \brief           Add event to the list, with counters of the button at the time of event
+ * \param[in,out]   evts: Events list
+ * \param[in]       time: Time of the event
+ * \param[in]       idx: Button index
+ * \param[in]       btn: Button of the event
+ * \param[in]       evt: Event type
+ * \return          Record, `NULL` if list is full
+ */
+btn_test_rec_t*
+test_evts_record(btn_test_evts_t* evts, uint32_t time, uint16_t idx, const lwbtn_btn_t* btn, lwbtn_evt_t evt) {
+    btn_test_rec_t* rec = test_evts_add(evts, time, idx, evt);
+
+    if (rec != NULL) {
+#if LWBTN_CFG_USE_KEEPALIVE
+        rec->keepalive_cnt = lwbtn_keepalive_get_count(btn);
+#endif /* LWBTN_CFG_USE_KEEPALIVE */
+#if LWBTN_CFG_USE_CLICK
+        rec->click_cnt = lwbtn_click_get_count(btn);
+#endif /* LWBTN_CFG_USE_CLICK */
+    }
+    (void)btn;
+    return rec;
+}
+
+/**
+ * \brief           Compare events of the group under test with the reference
+ * \param[in]       ref: Reference events, must not be empty
+ * \param[in]       dut: Events of the group under test
+ * \return          `0` when event streams are the same, `-1` otherwise
+ */
+int
+test_evts_compare(const btn_test_evts_t* ref, const btn_test_evts_t* dut) {
+    if (ref->cnt == 0 || ref->cnt != dut->cnt) {
+        printf("Events count mismatch: %u vs %u\r\n", (unsigned)ref->cnt, (unsigned)dut->cnt);
+        return -1;
+    }
+    for (size_t i = 0; i < ref->cnt; ++i) {
+        if (memcmp(&ref->recs[i], &dut->recs[i], sizeof(ref->recs[i])) != 0) {
+            printf("Event %u mismatch at time %u, btn %u\r\n", (unsigned)i, (unsigned)ref->recs[i].time,
+                   (unsigned)ref->recs[i].idx);
+            return -1;
+        }
+    }
+    return 0;
+}
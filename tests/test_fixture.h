@@ -0,0 +1,59 @@
+/**
+ * \file            test_fixture.h
+ * \brief           Random inputs and recorded events, shared by comparison tests
+ */
+#ifndef TEST_FIXTURE_HDR_H
+#define TEST_FIXTURE_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwbtn/lwbtn.h"
+
+/**
+ * \brief           Simulated input of one button
+ */
+typedef struct {
+    uint8_t state;      /*!< Current input state */
+    uint32_t remaining; /*!< Time to keep current state */
+} btn_test_input_t;
+
+/**
+ * \brief           Recorded event
+ */
+typedef struct {
+    uint32_t time;          /*!< Time of the event */
+    uint16_t idx;           /*!< Button index */
+    lwbtn_evt_t evt;        /*!< Event type */
+    uint16_t keepalive_cnt; /*!< Keep alive counter at the time of event */
+    uint8_t click_cnt;      /*!< Click counter at the time of event */
+    uint8_t active;         /*!< Button active status at the time of event */
+} btn_test_rec_t;
+
+/**
+ * \brief           List of recorded events
+ */
+typedef struct {
+    btn_test_rec_t* recs; /*!< Records array */
+    size_t size;          /*!< Number of records in array */
+    size_t cnt;           /*!< Number of recorded events */
+} btn_test_evts_t;
+
+/**
+ * \brief           Input edge callback, to notify the group under test
+ * \param[in]       idx: Button index
+ * \param[in]       state: New input state
+ */
+typedef void (*btn_test_edge_fn)(size_t idx, uint8_t state);
+
+void test_rand_init(uint32_t seed);
+uint32_t test_rand(void);
+
+void test_inputs_init(btn_test_input_t* inputs, size_t cnt, uint32_t remaining_max);
+uint8_t test_inputs_step(btn_test_input_t* inputs, size_t cnt, uint32_t long_max, btn_test_edge_fn edge_fn);
+
+btn_test_rec_t* test_evts_add(btn_test_evts_t* evts, uint32_t time, uint16_t idx, lwbtn_evt_t evt);
+btn_test_rec_t* test_evts_record(btn_test_evts_t* evts, uint32_t time, uint16_t idx, const lwbtn_btn_t* btn,
+                                 lwbtn_evt_t evt);
+int test_evts_compare(const btn_test_evts_t* ref, const btn_test_evts_t* dut);
+
+#endif /* TEST_FIXTURE_HDR_H */
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/* Test configuration, short tap is shorter than maximum debounce time */
+#define BTNS_CNT     2
+#define PRESS_PERIOD 400
+#define PRESS_TIME   150
+#define TAP_PERIOD   100
+#define TAP_TIME     25
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[BTNS_CNT];
+static uint8_t bounce_len[BTNS_CNT];
+static uint16_t onpress_cnt[BTNS_CNT], onrelease_cnt[BTNS_CNT];
+static uint32_t onpress_latency[BTNS_CNT];
+static uint32_t now, press_start, press_period = PRESS_PERIOD, press_time = PRESS_TIME;
+
+/* Input with contact bounce after both edges, toggling every 1 to 3 ms */
+static uint8_t
+prv_input(uint32_t idx, uint32_t time) {
+    uint32_t t = time % press_period, edge = t < press_time ? t : t - press_time;
+    uint8_t state = t < press_time;
+
+    if (edge < bounce_len[idx]) {
+        state ^= (uint8_t)(((edge * 7U) % 5U) < 2U);
+    }
+    return state;
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    return prv_input((uint32_t)(btn - btns), now);
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    size_t idx = btn - lwobj->btns;
+
+    if (evt == LWBTN_EVT_ONPRESS) {
+        ++onpress_cnt[idx];
+        onpress_latency[idx] = now - press_start;
+    } else if (evt == LWBTN_EVT_ONRELEASE) {
+        ++onrelease_cnt[idx];
+    }
+}
+
+/* Press both buttons specific number of times, and check that every press gives exactly one event pair */
+static int
+prv_presses(uint32_t presses) {
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        onpress_cnt[i] = onrelease_cnt[i] = 0;
+    }
+    for (uint32_t end = now + presses * press_period; now < end; ++now) {
+        if (now % press_period == 0) {
+            press_start = now;
+        }
+        lwbtn_process_ex(&lw, now);
+    }
+    printf("Debounce: %u %u, latency: %u %u\r\n", (unsigned)lwbtn_get_btn_debounce(&lw, &btns[0]),
+           (unsigned)lwbtn_get_btn_debounce(&lw, &btns[1]), (unsigned)onpress_latency[0],
+           (unsigned)onpress_latency[1]);
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        if (onpress_cnt[i] != presses || onrelease_cnt[i] != presses) {
+            printf("Button %u events: %u %u\r\n", (unsigned)i, (unsigned)onpress_cnt[i], (unsigned)onrelease_cnt[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_event);
+
+    /* New switch without bounce, and worn one with 12 ms of bounce */
+    bounce_len[0] = 0;
+    bounce_len[1] = 12;
+    if (lwbtn_get_btn_debounce(&lw, &btns[0]) != LWBTN_CFG_TIME_DEBOUNCE_PRESS) {
+        printf("TEST FAILED... initial debounce\r\n");
+        return -1;
+    }
+    /* Inputs must be inactive first */
+    now = PRESS_PERIOD - 1;
+    lwbtn_process_ex(&lw, now);
+    ++now;
+    if (prv_presses(20) != 0) {
+        printf("TEST FAILED... press events\r\n");
+        return -1;
+    }
+
+    /* New switch reacts faster, worn one filters its bounce */
+    if (lwbtn_get_btn_debounce(&lw, &btns[0]) != LWBTN_CFG_ADAPTIVE_DEBOUNCE_MARGIN
+        || onpress_latency[0] > LWBTN_CFG_ADAPTIVE_DEBOUNCE_MARGIN + 1 || lwbtn_get_btn_debounce(&lw, &btns[1]) < 12
+        || lwbtn_get_btn_debounce(&lw, &btns[1]) > LWBTN_CFG_TIME_DEBOUNCE_PRESS) {
+        printf("TEST FAILED... adapted debounce\r\n");
+        return -1;
+    }
+
+    /* Aging switch starts to bounce, debounce time follows */
+    bounce_len[0] = 16;
+    if (prv_presses(20) != 0 || lwbtn_get_btn_debounce(&lw, &btns[0]) < 16) {
+        printf("TEST FAILED... aging switch\r\n");
+        return -1;
+    }
+
+    /* Short taps of new switches, from the first one, every tap is detected */
+    memset(btns, 0x00, sizeof(btns));
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_event);
+    bounce_len[0] = bounce_len[1] = 0;
+    press_period = TAP_PERIOD;
+    press_time = TAP_TIME;
+    now = (now / press_period + 1) * press_period - 1;
+    lwbtn_process_ex(&lw, now);
+    ++now;
+    if (prv_presses(40) != 0 || lwbtn_get_btn_debounce(&lw, &btns[0]) != LWBTN_CFG_ADAPTIVE_DEBOUNCE_MARGIN) {
+        printf("TEST FAILED... short taps\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,13 @@
+# CMake include file
+
+# Add more sources
+target_sources(${CMAKE_PROJECT_NAME} PRIVATE
+    ${CMAKE_CURRENT_LIST_DIR}/test_lwbtn_atomic_threads.c
+)
+
+# Producers and processing run in separate threads
+find_package(Threads REQUIRED)
+target_link_libraries(${CMAKE_PROJECT_NAME} PRIVATE Threads::Threads)
+
+# Options file
+set(LWBTN_OPTS_FILE ${CMAKE_CURRENT_LIST_DIR}/lwbtn_opts.h)
@@ -0,0 +1,133 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/* Test configuration, every producer thread owns its share of buttons */
+#define BTNS_CNT      64
+#define PRODUCERS_CNT 4
+#define PRESSES       20
+#define CYCLE_TICKS   90
+#define MAX_TIME_MS   (PRESSES * CYCLE_TICKS + CYCLE_TICKS + 1000)
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[BTNS_CNT];
+static lwbtn_word_t active[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+
+/* Time of processing, and last time each producer has finished its inputs for */
+static volatile uint32_t time_current, producer_time[PRODUCERS_CNT];
+
+/* Events per button, written by processing thread only */
+static uint16_t onpress_cnt[BTNS_CNT], onrelease_cnt[BTNS_CNT];
+static uint32_t order_errors;
+
+/* Input of the button at specific time: bounce, stable press, bounce, stable release */
+static uint8_t
+prv_input(size_t idx, uint32_t time) {
+    static const uint8_t press_bounce[] = {1, 0, 1, 0}, release_bounce[] = {0, 1, 0, 1};
+    uint32_t offset = (uint32_t)(idx * 7U) % CYCLE_TICKS, pos;
+
+    if (time < offset || (time - offset) / CYCLE_TICKS >= PRESSES) {
+        return 0;
+    }
+    pos = (time - offset) % CYCLE_TICKS;
+    if (pos < 4) {
+        return press_bounce[pos];
+    } else if (pos < 44) {
+        return 1;
+    } else if (pos < 48) {
+        return release_bounce[pos - 44];
+    }
+    return 0;
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    size_t idx = btn - lwobj->btns;
+
+    /* Events of each button must alternate */
+    if (evt == LWBTN_EVT_ONPRESS) {
+        order_errors += onpress_cnt[idx] != onrelease_cnt[idx];
+        ++onpress_cnt[idx];
+    } else if (evt == LWBTN_EVT_ONRELEASE) {
+        order_errors += onpress_cnt[idx] != onrelease_cnt[idx] + 1;
+        ++onrelease_cnt[idx];
+    }
+}
+
+/* Producer sets input states of its buttons, while the group is being processed */
+static void*
+prv_producer(void* arg) {
+    size_t prod = (size_t)arg;
+
+    for (uint32_t time = 0; time < MAX_TIME_MS; ++time) {
+        while (__atomic_load_n(&time_current, __ATOMIC_ACQUIRE) < time) {
+            sched_yield();
+        }
+
+        /* Inputs are set and notified again until next time, to overlap with processing */
+        do {
+            for (size_t i = prod; i < BTNS_CNT; i += PRODUCERS_CNT) {
+                lwbtn_set_btn_state(&btns[i], prv_input(i, time));
+                lwbtn_notify_btn_change(&lw, &btns[i]);
+            }
+            __atomic_store_n(&producer_time[prod], time, __ATOMIC_RELEASE);
+            sched_yield();
+        } while (__atomic_load_n(&time_current, __ATOMIC_ACQUIRE) == time);
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    pthread_t producers[PRODUCERS_CNT];
+
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, NULL, prv_event);
+    lwbtn_active_set_init(&lw, active);
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        lwbtn_set_btn_state(&btns[i], 0);
+        lwbtn_notify_btn_change(&lw, &btns[i]);
+    }
+    for (size_t i = 0; i < PRODUCERS_CNT; ++i) {
+        if (pthread_create(&producers[i], NULL, prv_producer, (void*)i) != 0) {
+            printf("TEST FAILED... thread create\r\n");
+            return -1;
+        }
+    }
+
+    /* Inputs of each time are set while the same time is being processed */
+    for (uint32_t time = 0; time < MAX_TIME_MS; ++time) {
+        __atomic_store_n(&time_current, time, __ATOMIC_RELEASE);
+        lwbtn_process_ex(&lw, time);
+        for (size_t i = 0; i < PRODUCERS_CNT; ++i) {
+            while (time > 0 && __atomic_load_n(&producer_time[i], __ATOMIC_ACQUIRE) < time) {
+                sched_yield();
+            }
+        }
+    }
+
+    /* Release producers from their last time */
+    __atomic_store_n(&time_current, MAX_TIME_MS, __ATOMIC_RELEASE);
+    for (size_t i = 0; i < PRODUCERS_CNT; ++i) {
+        pthread_join(producers[i], NULL);
+    }
+
+    /* Every stable press gives exactly one on-press and on-release pair */
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        if (onpress_cnt[i] != PRESSES || onrelease_cnt[i] != PRESSES) {
+            printf("Button %u events: %u %u\r\n", (unsigned)i, (unsigned)onpress_cnt[i], (unsigned)onrelease_cnt[i]);
+            printf("TEST FAILED... events count\r\n");
+            return -1;
+        }
+    }
+    if (order_errors != 0) {
+        printf("TEST FAILED... events order\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/* Test configuration */
+#define BTNS_CNT    (2 * LWBTN_BS_BLOCK_BTNS + 7)
+#define MAX_TIME_MS 60000
+#define MAX_EVENTS  100000
+
+/* Reference and bit-sliced groups */
+static lwbtn_t ref_lw;
+static lwbtn_btn_t ref_btns[BTNS_CNT];
+static lwbtn_bs_t bs_lw;
+static lwbtn_btn_t bs_btns[BTNS_CNT];
+static lwbtn_bs_block_t bs_blocks[LWBTN_BS_BLOCKS_CNT(BTNS_CNT)];
+
+/* Inputs and recorded events */
+static btn_test_input_t inputs[BTNS_CNT];
+static btn_test_rec_t ref_recs[MAX_EVENTS], bs_recs[MAX_EVENTS];
+static btn_test_evts_t ref_evts = {ref_recs, MAX_EVENTS, 0}, bs_evts = {bs_recs, MAX_EVENTS, 0};
+static uint32_t time_current;
+
+static uint8_t
+prv_ref_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    (void)lw;
+    return inputs[btn - ref_btns].state;
+}
+
+static void
+prv_ref_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    (void)lw;
+    test_evts_record(&ref_evts, time_current, (uint16_t)(btn - ref_btns), btn, evt);
+}
+
+static lwbtn_word_t
+prv_bs_get_input(struct lwbtn_bs* lwbs, uint16_t block_idx) {
+    lwbtn_word_t word = 0;
+
+    for (size_t i = 0; i < LWBTN_BS_BLOCK_BTNS; ++i) {
+        size_t idx = (size_t)block_idx * LWBTN_BS_BLOCK_BTNS + i;
+        if (idx < BTNS_CNT && inputs[idx].state) {
+            word |= (lwbtn_word_t)1 << i;
+        }
+    }
+    (void)lwbs;
+    return word;
+}
+
+static void
+prv_bs_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    (void)lw;
+    test_evts_record(&bs_evts, time_current, (uint16_t)(btn - bs_btns), btn, evt);
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    test_rand_init(0x12345678);
+    test_inputs_init(inputs, BTNS_CNT, 100);
+    lwbtn_init_ex(&ref_lw, ref_btns, BTNS_CNT, prv_ref_get_state, prv_ref_event);
+    if (!lwbtn_bs_init(&bs_lw, bs_btns, BTNS_CNT, bs_blocks, 1, prv_bs_get_input, prv_bs_event)) {
+        printf("Bit-sliced group init failed\r\n");
+        return -1;
+    }
+
+    /* Different timings per button, when enabled */
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+#if LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC
+        ref_btns[i].time_keepalive_period = bs_btns[i].time_keepalive_period = 50 + (i % 4) * 25;
+#endif /* LWBTN_CFG_TIME_KEEPALIVE_PERIOD_DYNAMIC */
+#if LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC
+        ref_btns[i].time_click_multi_max = bs_btns[i].time_click_multi_max = 200 + (i % 3) * 100;
+#endif /* LWBTN_CFG_TIME_CLICK_MULTI_MAX_DYNAMIC */
+    }
+
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        test_inputs_step(inputs, BTNS_CNT, 2000, NULL);
+
+        /* Reset random button from time to time */
+        if ((time_current % 1777) == 1000) {
+            size_t idx = test_rand() % BTNS_CNT;
+            lwbtn_reset(NULL, &ref_btns[idx]);
+            lwbtn_bs_reset(&bs_lw, &bs_btns[idx]);
+        }
+        lwbtn_process_ex(&ref_lw, time_current);
+        lwbtn_bs_process(&bs_lw, time_current);
+    }
+
+    /* Compare event streams */
+    printf("Reference events: %u, bit-sliced events: %u\r\n", (unsigned)ref_evts.cnt, (unsigned)bs_evts.cnt);
+    if (test_evts_compare(&ref_evts, &bs_evts) != 0) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+    return 0;
+}
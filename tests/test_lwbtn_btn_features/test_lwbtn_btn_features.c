@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/**
+ * \brief           Group under test with its recorded events
+ */
+typedef struct {
+    lwbtn_t lw;                /*!< Button group */
+    lwbtn_btn_t btns[8];       /*!< Buttons of the group */
+    btn_test_rec_t recs[5000]; /*!< Recorded events array */
+    btn_test_evts_t evts;      /*!< List of recorded events */
+} btn_test_group_t;
+
+/* Test configuration */
+#define BTNS_CNT    8
+#define MAX_TIME_MS 20000
+
+/* Reference group with all features, and group with different features per button */
+static btn_test_group_t ref, feat;
+static lwbtn_word_t ref_active[LWBTN_BITMAP_WORDS(BTNS_CNT)], feat_active[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+static btn_test_input_t inputs[BTNS_CNT];
+static uint32_t time_current;
+
+/* Attach records array to the list of recorded events */
+static void
+prv_group_init(btn_test_group_t* grp) {
+    grp->evts.recs = grp->recs;
+    grp->evts.size = sizeof(grp->recs) / sizeof(grp->recs[0]);
+    grp->evts.cnt = 0;
+}
+
+/* Input edge is notified to both groups */
+static void
+prv_input_edge(size_t idx, uint8_t state) {
+    lwbtn_notify_btn_change(&ref.lw, &ref.btns[idx]);
+    lwbtn_notify_btn_change(&feat.lw, &feat.btns[idx]);
+    (void)state;
+}
+
+/* Features of the button in the group under test */
+static uint8_t
+prv_btn_features(size_t idx) {
+    return (uint8_t)(idx % 4);
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    return inputs[btn - lw->btns].state;
+}
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    btn_test_group_t* grp = lw == &ref.lw ? &ref : &feat;
+    btn_test_rec_t* rec;
+    uint16_t idx = (uint16_t)(btn - lw->btns);
+
+    /* Reference only keeps events, that the button with limited features sends */
+    if (grp == &ref
+        && ((evt == LWBTN_EVT_ONCLICK && !(prv_btn_features(idx) & LWBTN_BTN_FEATURE_CLICK))
+            || (evt == LWBTN_EVT_KEEPALIVE && !(prv_btn_features(idx) & LWBTN_BTN_FEATURE_KEEPALIVE)))) {
+        return;
+    }
+    rec = test_evts_add(&grp->evts, time_current, idx, evt);
+    if (rec != NULL && evt == LWBTN_EVT_ONCLICK) {
+        rec->click_cnt = lwbtn_click_get_count(btn);
+    }
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_time_t deadline;
+
+    test_rand_init(0x1234ABCD);
+    prv_group_init(&ref);
+    prv_group_init(&feat);
+    lwbtn_init_ex(&ref.lw, ref.btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_init_ex(&feat.lw, feat.btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_active_set_init(&ref.lw, ref_active);
+    lwbtn_active_set_init(&feat.lw, feat_active);
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        if (!lwbtn_set_btn_features(&feat.lw, &feat.btns[i], prv_btn_features(i))) {
+            printf("TEST FAILED... features setup\r\n");
+            return -1;
+        }
+    }
+
+    /* Same inputs for both groups */
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        test_inputs_step(inputs, BTNS_CNT, 1000, prv_input_edge);
+        lwbtn_process_ex(&ref.lw, time_current);
+        lwbtn_process_ex(&feat.lw, time_current);
+    }
+    printf("Events: %u, %u\r\n", (unsigned)ref.evts.cnt, (unsigned)feat.evts.cnt);
+    if (test_evts_compare(&ref.evts, &feat.evts) != 0) {
+        printf("TEST FAILED... per-button features\r\n");
+        return -1;
+    }
+
+    /* Held buttons without keep alive have no pending work */
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        lwbtn_set_btn_features(&feat.lw, &feat.btns[i], LWBTN_BTN_FEATURE_CLICK * (i % 2));
+        inputs[i].state = 1;
+        lwbtn_notify_btn_change(&feat.lw, &feat.btns[i]);
+    }
+    for (uint32_t end = time_current + 2000; time_current < end; ++time_current) {
+        lwbtn_process_ex(&feat.lw, time_current);
+    }
+    if (lwbtn_get_next_deadline(&feat.lw, time_current, &deadline) != LWBTN_DEADLINE_IDLE) {
+        printf("TEST FAILED... pending work of held buttons\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/**
+ * \brief           Events received by one button
+ */
+typedef struct {
+    uint32_t onpress;       /*!< Number of on-press events */
+    uint32_t onrelease;     /*!< Number of on-release events */
+    uint32_t onclick;       /*!< Number of on-click events */
+    uint16_t keepalive_cnt; /*!< Keep alive counter of last on-release event */
+    uint8_t click_cnt;      /*!< Click counter of last on-click event */
+} btn_test_stat_t;
+
+/* Test configuration */
+#define BTNS_CNT 2
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[BTNS_CNT];
+static lwbtn_btn_params_t params[BTNS_CNT];
+static btn_test_stat_t stats[BTNS_CNT];
+static uint8_t input;
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return input;
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    btn_test_stat_t* stat = &stats[btn - lwobj->btns];
+
+    switch (evt) {
+        case LWBTN_EVT_ONPRESS: ++stat->onpress; break;
+        case LWBTN_EVT_ONRELEASE:
+            ++stat->onrelease;
+            stat->keepalive_cnt = btn->keepalive.cnt;
+            break;
+        case LWBTN_EVT_ONCLICK:
+            ++stat->onclick;
+            stat->click_cnt = btn->click.cnt;
+            break;
+        default: break;
+    }
+}
+
+/* Keep input in specific state from start to end time, processing every millisecond */
+static void
+prv_run(uint8_t state, uint32_t start, uint32_t end) {
+    input = state;
+    for (uint32_t time = start; time < end; ++time) {
+        lwbtn_process_ex(&lw, time);
+    }
+}
+
+/* Check statistics of the button after the sequence */
+static int
+prv_check(size_t idx, uint32_t onclick, uint8_t click_cnt, uint16_t keepalive_cnt) {
+    btn_test_stat_t* stat = &stats[idx];
+
+    printf("Button %u: press: %u, release: %u, click: %u (%u), keep alive: %u\r\n", (unsigned)idx,
+           (unsigned)stat->onpress, (unsigned)stat->onrelease, (unsigned)stat->onclick, (unsigned)stat->click_cnt,
+           (unsigned)stat->keepalive_cnt);
+    if (stat->onpress != 1 || stat->onrelease != 1 || stat->onclick != onclick || stat->click_cnt != click_cnt
+        || stat->keepalive_cnt != keepalive_cnt) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_params_init(&lw, params);
+    params[1].time_keepalive_period = 250;
+
+    printf("Button size: %u bytes\r\n", (unsigned)sizeof(lwbtn_btn_t));
+
+    /* Click over the 16-bit time wrap, on-press at 65420, release at 65600 */
+    prv_run(0, 60000, 65400);
+    prv_run(1, 65400, 65600);
+    prv_run(0, 65600, 70000);
+    if (prv_check(0, 1, 1, 1) != 0 || prv_check(1, 1, 1, 0) != 0) {
+        printf("TEST FAILED... click over time wrap\r\n");
+        return -1;
+    }
+
+    /* Press for 65536 + 100 ms, wrapped press time would look like a click */
+    memset(stats, 0x00, sizeof(stats));
+    prv_run(1, 70000, 135656);
+    prv_run(0, 135656, 137000);
+    if (prv_check(0, 0, 0, 656) != 0 || prv_check(1, 0, 0, 262) != 0) {
+        printf("TEST FAILED... long press\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/* Test configuration */
+#define BTNS_CNT    16
+#define MAX_TIME_MS 60000
+#define MAX_EVENTS  50000
+#define RESET_TIME  3000
+
+/* Reference group, processed every millisecond, and tickless group */
+static lwbtn_t ref_lw, tl_lw;
+static lwbtn_btn_t ref_btns[BTNS_CNT], tl_btns[BTNS_CNT];
+#if LWBTN_CFG_USE_ACTIVE_SET
+static lwbtn_word_t tl_active[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+#if LWBTN_CFG_USE_STATE_MASK
+static lwbtn_word_t tl_state_mask[LWBTN_STATE_MASK_WORDS(BTNS_CNT)];
+#endif /* LWBTN_CFG_USE_STATE_MASK */
+
+/* Inputs and recorded events */
+static btn_test_input_t inputs[BTNS_CNT];
+static btn_test_rec_t ref_recs[MAX_EVENTS], tl_recs[MAX_EVENTS];
+static btn_test_evts_t ref_evts = {ref_recs, MAX_EVENTS, 0}, tl_evts = {tl_recs, MAX_EVENTS, 0};
+static uint32_t time_current, tl_get_state_calls, tl_calls, idle_cnt;
+static lwbtn_time_t tl_deadline;
+static lwbtn_deadline_t tl_res = LWBTN_DEADLINE_IDLE;
+
+/* Input edge is set to both groups, and notified to tickless group */
+static void
+prv_input_edge(size_t idx, uint8_t state) {
+#if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL
+    lwbtn_set_btn_state(&ref_btns[idx], state);
+    lwbtn_set_btn_state(&tl_btns[idx], state);
+#endif /* LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL */
+#if LWBTN_CFG_USE_ACTIVE_SET && !LWBTN_CFG_USE_STATE_MASK
+    lwbtn_notify_btn_change(&tl_lw, &tl_btns[idx]);
+#endif /* LWBTN_CFG_USE_ACTIVE_SET && !LWBTN_CFG_USE_STATE_MASK */
+    (void)idx;
+    (void)state;
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    tl_get_state_calls += lw == &tl_lw;
+    return inputs[btn - lw->btns].state;
+}
+
+#if LWBTN_CFG_USE_STATE_MASK
+static void
+prv_get_state_mask(struct lwbtn* lw, lwbtn_word_t* mask, uint16_t words_cnt) {
+    memset(mask, 0x00, words_cnt * sizeof(*mask));
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        mask[i / LWBTN_WORD_BITS] |= (lwbtn_word_t)inputs[i].state << (i % LWBTN_WORD_BITS);
+    }
+    (void)lw;
+}
+#endif /* LWBTN_CFG_USE_STATE_MASK */
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    test_evts_record(lw == &ref_lw ? &ref_evts : &tl_evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+}
+
+/* Process reference group every millisecond, and tickless group only on input edge or when deadline is due */
+static void
+prv_process(uint8_t edge) {
+    lwbtn_process_ex(&ref_lw, time_current);
+    if (time_current == 0 || edge
+        || (tl_res == LWBTN_DEADLINE_PENDING && (int32_t)(time_current - tl_deadline) >= 0)) {
+        lwbtn_process_ex(&tl_lw, time_current);
+        tl_res = lwbtn_get_next_deadline(&tl_lw, time_current, &tl_deadline);
+        idle_cnt += tl_res == LWBTN_DEADLINE_IDLE;
+        ++tl_calls;
+    }
+}
+
+/* Set input of the button, return `1` if it has changed */
+static uint8_t
+prv_input_set(size_t idx, uint8_t state) {
+    if (inputs[idx].state == state) {
+        return 0;
+    }
+    inputs[idx].state = state;
+    prv_input_edge(idx, state);
+    return 1;
+}
+
+/*
+ * Reset both groups while all buttons are released, and press first button twice.
+ * Released button must not wait for the input edge to receive its first inactive state.
+ */
+static int
+prv_test_reset_released(void) {
+    size_t tl_evts_start = tl_evts.cnt;
+    uint32_t onpress_cnt = 0;
+    uint8_t edge;
+
+    for (uint32_t start = time_current; time_current < start + RESET_TIME; ++time_current) {
+        uint32_t t = time_current - start;
+
+        edge = 0;
+        for (size_t i = 0; i < BTNS_CNT; ++i) {
+            edge |= prv_input_set(i, i == 0 && ((t >= 1000 && t < 1100) || (t >= 2000 && t < 2100)));
+        }
+        if (t == 500) {
+            lwbtn_reset(&ref_lw, NULL);
+            lwbtn_reset(&tl_lw, NULL);
+            tl_res = lwbtn_get_next_deadline(&tl_lw, time_current, &tl_deadline);
+        }
+        prv_process(edge);
+    }
+    for (size_t i = tl_evts_start; i < tl_evts.cnt; ++i) {
+        onpress_cnt += tl_evts.recs[i].idx == 0 && tl_evts.recs[i].evt == LWBTN_EVT_ONPRESS;
+    }
+    printf("On-press events after reset: %u\r\n", (unsigned)onpress_cnt);
+    return onpress_cnt == 2 ? 0 : -1;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    test_rand_init(0x87654321);
+    test_inputs_init(inputs, BTNS_CNT, 100);
+    lwbtn_init_ex(&ref_lw, ref_btns, BTNS_CNT, prv_get_state, prv_event);
+#if LWBTN_CFG_USE_STATE_MASK
+    /* Whole group is read with single call, get state function is not needed */
+    lwbtn_init_ex(&tl_lw, tl_btns, BTNS_CNT, NULL, prv_event);
+    lwbtn_state_mask_init(&tl_lw, tl_state_mask, prv_get_state_mask);
+#else  /* LWBTN_CFG_USE_STATE_MASK */
+    lwbtn_init_ex(&tl_lw, tl_btns, BTNS_CNT, prv_get_state, prv_event);
+#endif /* LWBTN_CFG_USE_STATE_MASK */
+#if LWBTN_CFG_USE_ACTIVE_SET
+    lwbtn_active_set_init(&tl_lw, tl_active);
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+#if LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        lwbtn_set_btn_state(&ref_btns[i], inputs[i].state);
+        lwbtn_set_btn_state(&tl_btns[i], inputs[i].state);
+    }
+#endif /* LWBTN_CFG_GET_STATE_MODE == LWBTN_GET_STATE_MODE_MANUAL */
+
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        prv_process(test_inputs_step(inputs, BTNS_CNT, 5000, prv_input_edge));
+    }
+    if (prv_test_reset_released() != 0) {
+        printf("TEST FAILED... reset of released buttons\r\n");
+        return -1;
+    }
+
+    /* Compare event streams */
+    printf("Reference events: %u, tickless events: %u, tickless calls: %u, idle results: %u, get state calls: %u\r\n",
+           (unsigned)ref_evts.cnt, (unsigned)tl_evts.cnt, (unsigned)tl_calls, (unsigned)idle_cnt,
+           (unsigned)tl_get_state_calls);
+    if (test_evts_compare(&ref_evts, &tl_evts) != 0 || tl_calls >= MAX_TIME_MS || idle_cnt == 0) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+#if LWBTN_CFG_USE_STATE_MASK
+    if (tl_get_state_calls != 0) {
+        printf("TEST FAILED... get state function called with state mask\r\n");
+        return -1;
+    }
+#endif /* LWBTN_CFG_USE_STATE_MASK */
+#if LWBTN_CFG_USE_ACTIVE_SET
+    /* Idle buttons are not part of active set and must not be read */
+    if (tl_get_state_calls >= (uint32_t)BTNS_CNT * tl_calls * 3 / 4) {
+        printf("TEST FAILED... get state function called for idle buttons\r\n");
+        return -1;
+    }
+#endif /* LWBTN_CFG_USE_ACTIVE_SET */
+    return 0;
+}
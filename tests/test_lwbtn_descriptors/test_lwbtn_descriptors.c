@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/**
+ * \brief           Events received by one button
+ */
+typedef struct {
+    uint32_t onpress;   /*!< Number of on-press events */
+    uint32_t onrelease; /*!< Number of on-release events */
+    uint32_t onclick;   /*!< Number of on-click events */
+    uint32_t keepalive; /*!< Number of keep alive events */
+} btn_test_stat_t;
+
+/* Test configuration */
+#define BTNS_CNT 4
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[BTNS_CNT];
+static btn_test_stat_t stats[BTNS_CNT];
+static uint8_t input;
+
+/* Default timing and slow keep alive profile */
+static const lwbtn_profile_t profiles[] = {
+    LWBTN_PROFILE_DEFAULT,
+    {20, 0, 20, 300, 400, 250, 3},
+};
+
+/* Constant part of the buttons, statistics are found through user argument */
+static const lwbtn_btn_desc_t descs[BTNS_CNT] = {
+    {.arg = &stats[0], .input = 0, .profile = 0, .features = LWBTN_BTN_FEATURES_ALL},
+    {.arg = &stats[1], .input = 1, .profile = 0, .features = LWBTN_BTN_FEATURE_CLICK},
+    {.arg = &stats[2], .input = 2, .profile = 1, .features = LWBTN_BTN_FEATURE_KEEPALIVE},
+    {.arg = &stats[3], .input = 3, .profile = 1, .features = 0},
+};
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    return (input >> lwbtn_get_btn_desc(lwobj, btn)->input) & 0x01;
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    btn_test_stat_t* stat = lwbtn_get_btn_desc(lwobj, btn)->arg;
+
+    switch (evt) {
+        case LWBTN_EVT_ONPRESS: ++stat->onpress; break;
+        case LWBTN_EVT_ONRELEASE: ++stat->onrelease; break;
+        case LWBTN_EVT_ONCLICK: ++stat->onclick; break;
+        case LWBTN_EVT_KEEPALIVE: ++stat->keepalive; break;
+        default: break;
+    }
+}
+
+/* Press all buttons for specific time and check the events of each button */
+static int
+prv_press(uint32_t start, uint32_t duration, const btn_test_stat_t* exp) {
+    int ret = 0;
+
+    memset(stats, 0x00, sizeof(stats));
+    for (uint32_t time = start; time < start + duration + 1000; ++time) {
+        input = time < start + duration ? 0x0F : 0x00;
+        lwbtn_process_ex(&lw, time);
+    }
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        printf("Button %u: press: %u, release: %u, click: %u, keep alive: %u\r\n", (unsigned)i,
+               (unsigned)stats[i].onpress, (unsigned)stats[i].onrelease, (unsigned)stats[i].onclick,
+               (unsigned)stats[i].keepalive);
+        if (memcmp(&stats[i], &exp[i], sizeof(stats[i])) != 0) {
+            ret = -1;
+        }
+    }
+    return ret;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    static const btn_test_stat_t exp_click[BTNS_CNT] = {{1, 1, 1, 0}, {1, 1, 1, 0}, {1, 1, 0, 0}, {1, 1, 0, 0}};
+    static const btn_test_stat_t exp_long[BTNS_CNT] = {{1, 1, 0, 9}, {1, 1, 0, 0}, {1, 1, 0, 3}, {1, 1, 0, 0}};
+
+    printf("Button size: %u bytes, descriptor size: %u bytes\r\n", (unsigned)sizeof(lwbtn_btn_t),
+           (unsigned)sizeof(lwbtn_btn_desc_t));
+
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_event);
+    if (!lwbtn_profiles_init(&lw, profiles, sizeof(profiles) / sizeof(profiles[0]))
+        || !lwbtn_descs_init(&lw, descs)) {
+        printf("TEST FAILED... setup\r\n");
+        return -1;
+    }
+
+    /* Inputs must be inactive first */
+    lwbtn_process_ex(&lw, 0);
+    if (prv_press(1, 80, exp_click) != 0) {
+        printf("TEST FAILED... click\r\n");
+        return -1;
+    }
+    if (prv_press(2000, 1000, exp_long) != 0) {
+        printf("TEST FAILED... long press\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/**
+ * \brief           Input edge or processing call of the test sequence
+ */
+typedef struct {
+    uint32_t time; /*!< Time of the edge or processing call */
+    int8_t state;  /*!< Edge state, `-1` for processing call */
+} test_step_t;
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[1];
+static lwbtn_edge_t edges[8];
+static lwbtn_evt_rec_t evts[16];
+
+/* Bouncy press and release between slow processing calls, then press shorter than processing period */
+static const test_step_t steps[] = {
+    {0, -1},   {110, 1},  {112, 0},  {113, 1},  {150, -1}, {160, 0},  {200, -1}, {300, -1},
+    {400, -1}, {500, -1}, {600, -1}, {1010, 1}, {1060, 0}, {1100, -1}, {1500, -1},
+};
+
+/* Events with time of their detection, not time of processing call */
+static const lwbtn_evt_rec_t exp_evts[] = {
+    {133, 0, 0, LWBTN_EVT_ONPRESS, 0},  {160, 0, 0, LWBTN_EVT_ONRELEASE, 0},  {560, 0, 0, LWBTN_EVT_ONCLICK, 1},
+    {1030, 0, 0, LWBTN_EVT_ONPRESS, 0}, {1060, 0, 0, LWBTN_EVT_ONRELEASE, 0}, {1460, 0, 0, LWBTN_EVT_ONCLICK, 1},
+};
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return 0;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_evt_rec_t rec;
+    lwbtn_time_t deadline;
+    size_t evts_cnt = 0;
+
+    lwbtn_init_ex(&lw, btns, 1, prv_get_state, NULL);
+    lwbtn_evt_queue_init(&lw, evts, sizeof(evts) / sizeof(evts[0]), LWBTN_EVT_QUEUE_DROP_NEWEST);
+    lwbtn_edge_queue_init(&lw, edges, sizeof(edges) / sizeof(edges[0]));
+
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); ++i) {
+        if (steps[i].state < 0) {
+            lwbtn_process_ex(&lw, steps[i].time);
+            continue;
+        }
+        lwbtn_push_edge(&lw, &btns[0], (uint8_t)steps[i].state, steps[i].time);
+
+        /* Queued edge must be processed as soon as possible */
+        if (lwbtn_get_next_deadline(&lw, steps[i].time, &deadline) != LWBTN_DEADLINE_PENDING
+            || deadline != steps[i].time) {
+            printf("TEST FAILED... deadline with queued edge\r\n");
+            return -1;
+        }
+    }
+
+    while (lwbtn_poll_event(&lw, &rec)) {
+        printf("Event %u at %u ms, click count: %u\r\n", (unsigned)rec.evt, (unsigned)rec.time,
+               (unsigned)rec.click_cnt);
+        if (evts_cnt >= sizeof(exp_evts) / sizeof(exp_evts[0]) || rec.time != exp_evts[evts_cnt].time
+            || rec.evt != exp_evts[evts_cnt].evt || rec.click_cnt != exp_evts[evts_cnt].click_cnt) {
+            printf("TEST FAILED... unexpected event\r\n");
+            return -1;
+        }
+        ++evts_cnt;
+    }
+    if (evts_cnt != sizeof(exp_evts) / sizeof(exp_evts[0])) {
+        printf("TEST FAILED... missing events\r\n");
+        return -1;
+    }
+    return 0;
+}
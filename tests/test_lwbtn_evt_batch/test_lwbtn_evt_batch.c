@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/**
+ * \brief           Group under test with its recorded events
+ */
+typedef struct {
+    lwbtn_t lw;                /*!< Button group */
+    lwbtn_btn_t btns[8];       /*!< Buttons of the group */
+    btn_test_rec_t recs[5000]; /*!< Recorded events array */
+    btn_test_evts_t evts;      /*!< List of recorded events */
+} btn_test_group_t;
+
+/* Test configuration, small batch is smaller than events of one processing call */
+#define BTNS_CNT         8
+#define BATCH_SIZE       32
+#define BATCH_SIZE_SMALL 2
+#define MAX_TIME_MS      20000
+
+/* Reference group with immediate events, group with batched events function and with one by one delivery */
+static btn_test_group_t ref, batch, single, small;
+static lwbtn_evt_rec_t batch_recs[BATCH_SIZE], single_recs[BATCH_SIZE], small_recs[BATCH_SIZE_SMALL];
+static btn_test_input_t inputs[BTNS_CNT];
+static uint32_t time_current, batch_calls, reset_at_keepalive, small_inactive_at_delivery;
+
+/* Attach records array to the list of recorded events */
+static void
+prv_group_init(btn_test_group_t* grp) {
+    grp->evts.recs = grp->recs;
+    grp->evts.size = sizeof(grp->recs) / sizeof(grp->recs[0]);
+    grp->evts.cnt = 0;
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    return inputs[btn - lw->btns].state;
+}
+
+/* Reset whole group at first event, it must only be called after all buttons are processed */
+static void
+prv_event_small(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    test_evts_record(&small.evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        small_inactive_at_delivery += !lwbtn_is_btn_active(&lw->btns[i]);
+    }
+    lwbtn_reset(lw, NULL);
+}
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    btn_test_group_t* grp = lw == &ref.lw ? &ref : &single;
+
+    test_evts_record(&grp->evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+
+    /* Modify the group from event function, on button data of the event */
+    if (reset_at_keepalive > 0 && evt == LWBTN_EVT_KEEPALIVE && btn->keepalive.cnt == reset_at_keepalive) {
+        lwbtn_reset(NULL, btn);
+    }
+}
+
+static void
+prv_event_batch(struct lwbtn* lw, const lwbtn_evt_rec_t* recs, uint16_t recs_cnt) {
+    btn_test_rec_t* rec;
+
+    ++batch_calls;
+    for (size_t i = 0; i < recs_cnt; ++i) {
+        rec = test_evts_add(&batch.evts, time_current, recs[i].btn_idx, (lwbtn_evt_t)recs[i].evt);
+        if (rec != NULL) {
+            rec->keepalive_cnt = recs[i].keepalive_cnt;
+            rec->click_cnt = recs[i].click_cnt;
+        }
+    }
+    (void)lw;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    uint32_t calls_with_evts = 0;
+    size_t evts_cnt;
+
+    test_rand_init(0x1234ABCD);
+    prv_group_init(&ref);
+    prv_group_init(&batch);
+    prv_group_init(&single);
+    prv_group_init(&small);
+    lwbtn_init_ex(&ref.lw, ref.btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_init_ex(&batch.lw, batch.btns, BTNS_CNT, prv_get_state, NULL);
+    lwbtn_init_ex(&single.lw, single.btns, BTNS_CNT, prv_get_state, prv_event);
+    if (lwbtn_evt_batch_init(&batch.lw, batch_recs, 0, prv_event_batch)
+        || !lwbtn_evt_batch_init(&batch.lw, batch_recs, BATCH_SIZE, prv_event_batch)
+        || !lwbtn_evt_batch_init(&single.lw, single_recs, BATCH_SIZE, NULL)) {
+        printf("TEST FAILED... batch setup\r\n");
+        return -1;
+    }
+
+    /* Same inputs for all groups */
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        test_inputs_step(inputs, BTNS_CNT, 1000, NULL);
+        evts_cnt = ref.evts.cnt;
+        lwbtn_process_ex(&ref.lw, time_current);
+        lwbtn_process_ex(&batch.lw, time_current);
+        lwbtn_process_ex(&single.lw, time_current);
+        calls_with_evts += ref.evts.cnt != evts_cnt;
+    }
+    printf("Events: %u, processing calls with events: %u, batch calls: %u\r\n", (unsigned)ref.evts.cnt,
+           (unsigned)calls_with_evts, (unsigned)batch_calls);
+    if (test_evts_compare(&ref.evts, &batch.evts) != 0 || test_evts_compare(&ref.evts, &single.evts) != 0
+        || batch_calls != calls_with_evts
+        || batch.lw.evt_batch.dropped != 0 || single.lw.evt_batch.dropped != 0) {
+        printf("TEST FAILED... batched events\r\n");
+        return -1;
+    }
+
+    /* Reset the button from event function, at third keep alive event of long press */
+    memset(inputs, 0x00, sizeof(inputs));
+    for (uint32_t end = time_current + 1000; time_current < end; ++time_current) {
+        lwbtn_process_ex(&single.lw, time_current);
+    }
+    single.evts.cnt = 0;
+    reset_at_keepalive = 3;
+    inputs[0].state = 1;
+    for (uint32_t end = time_current + 1000; time_current < end; ++time_current) {
+        lwbtn_process_ex(&single.lw, time_current);
+    }
+    inputs[0].state = 0;
+    for (uint32_t end = time_current + 1000; time_current < end; ++time_current) {
+        lwbtn_process_ex(&single.lw, time_current);
+    }
+    printf("Events after reset: %u\r\n", (unsigned)single.evts.cnt);
+    if (single.evts.cnt != 4 || single.recs[0].evt != LWBTN_EVT_ONPRESS || single.recs[3].evt != LWBTN_EVT_KEEPALIVE
+        || single.recs[3].keepalive_cnt != 3) {
+        printf("TEST FAILED... reset from event function\r\n");
+        return -1;
+    }
+
+    /* Press all buttons at once, batch overflows and event function resets the group */
+    lwbtn_init_ex(&small.lw, small.btns, BTNS_CNT, prv_get_state, prv_event_small);
+    lwbtn_evt_batch_init(&small.lw, small_recs, BATCH_SIZE_SMALL, NULL);
+    memset(inputs, 0x00, sizeof(inputs));
+    for (uint32_t end = time_current + 1000; time_current < end; ++time_current) {
+        lwbtn_process_ex(&small.lw, time_current);
+    }
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        inputs[i].state = 1;
+    }
+    for (uint32_t end = time_current + 2000; time_current < end; ++time_current) {
+        lwbtn_process_ex(&small.lw, time_current);
+    }
+    memset(inputs, 0x00, sizeof(inputs));
+    for (uint32_t end = time_current + 1000; time_current < end; ++time_current) {
+        lwbtn_process_ex(&small.lw, time_current);
+    }
+    printf("Events with small batch: %u, dropped: %u\r\n", (unsigned)small.evts.cnt,
+           (unsigned)small.lw.evt_batch.dropped);
+    if (small.evts.cnt != BATCH_SIZE_SMALL || small.lw.evt_batch.dropped != BTNS_CNT - BATCH_SIZE_SMALL
+        || small.recs[0].evt != LWBTN_EVT_ONPRESS || small.recs[1].evt != LWBTN_EVT_ONPRESS
+        || small_inactive_at_delivery != 0) {
+        printf("TEST FAILED... batch overflow\r\n");
+        return -1;
+    }
+    return 0;
+}
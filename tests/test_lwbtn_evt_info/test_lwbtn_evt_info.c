@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/* Test configuration */
+#define RECS_SIZE 32
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[1];
+static lwbtn_evt_rec_t recs[RECS_SIZE];
+static size_t recs_cnt;
+static uint8_t input;
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return input;
+}
+
+static void
+prv_evt_info(struct lwbtn* lwobj, const lwbtn_evt_rec_t* rec) {
+    (void)lwobj;
+    if (recs_cnt < RECS_SIZE) {
+        recs[recs_cnt++] = *rec;
+    }
+}
+
+/* Keep input in specific state from start to end time, processing every millisecond */
+static void
+prv_run(uint8_t state, uint32_t start, uint32_t end) {
+    input = state;
+    for (uint32_t time = start; time < end; ++time) {
+        lwbtn_process_ex(&lw, time);
+    }
+}
+
+/* Find n-th record of specific event */
+static const lwbtn_evt_rec_t*
+prv_find(lwbtn_evt_t evt, size_t n) {
+    for (size_t i = 0; i < recs_cnt; ++i) {
+        if (recs[i].evt == evt && n-- == 0) {
+            return &recs[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    const lwbtn_evt_rec_t *press, *release, *keepalive, *press2, *release2, *click;
+
+    /* Event function is optional, when event info function is used */
+    if (!lwbtn_init_ex(&lw, btns, 1, prv_get_state, NULL) || !lwbtn_evt_info_init(&lw, prv_evt_info)) {
+        printf("TEST FAILED... init\r\n");
+        return -1;
+    }
+
+    /* Long press with keep alive events */
+    prv_run(0, 0, 100);
+    prv_run(1, 100, 450);
+    prv_run(0, 450, 1500);
+    press = prv_find(LWBTN_EVT_ONPRESS, 0);
+    release = prv_find(LWBTN_EVT_ONRELEASE, 0);
+    keepalive = prv_find(LWBTN_EVT_KEEPALIVE, 2);
+    if (press == NULL || release == NULL || keepalive == NULL || press->time_pressed != 0
+        || release->time_pressed != release->time - press->time || keepalive->time_pressed != 300
+        || keepalive->keepalive_cnt != 3 || release->time_click_gap != 0) {
+        printf("TEST FAILED... press duration\r\n");
+        return -1;
+    }
+    printf("Pressed for %u ms\r\n", (unsigned)release->time_pressed);
+
+    /* Double click, gap is measured from last click of the sequence */
+    recs_cnt = 0;
+    prv_run(1, 1500, 1600);
+    prv_run(0, 1600, 1700);
+    prv_run(1, 1700, 1800);
+    prv_run(0, 1800, 3000);
+    press2 = prv_find(LWBTN_EVT_ONPRESS, 1);
+    release = prv_find(LWBTN_EVT_ONRELEASE, 0);
+    release2 = prv_find(LWBTN_EVT_ONRELEASE, 1);
+    click = prv_find(LWBTN_EVT_ONCLICK, 0);
+    if (press2 == NULL || release == NULL || release2 == NULL || click == NULL || click->click_cnt != 2
+        || release->time_click_gap != 0 || press2->time_click_gap != press2->time - release->time
+        || release2->time_click_gap != release2->time - release->time
+        || click->time_click_gap != click->time - release2->time
+        || release2->time_pressed != release2->time - press2->time) {
+        printf("TEST FAILED... click gap\r\n");
+        return -1;
+    }
+    printf("Click gap %u ms, click sent after %u ms\r\n", (unsigned)release2->time_click_gap,
+           (unsigned)click->time_click_gap);
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/* Test configuration */
+#define BTNS_CNT 3
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[BTNS_CNT];
+static uint32_t evts[BTNS_CNT][LWBTN_EVT_CNT];
+static uint16_t keepalive_cnt[BTNS_CNT];
+static uint8_t input;
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return input;
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    ++evts[btn - lwobj->btns][evt];
+}
+
+static void
+prv_event_release(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    keepalive_cnt[btn - lwobj->btns] = btn->keepalive.cnt;
+    prv_event(lwobj, btn, evt);
+}
+
+/* One handler per event type, keep alive events are dropped */
+static const lwbtn_evt_fn evt_fns[LWBTN_EVT_CNT] = {
+    [LWBTN_EVT_ONPRESS] = prv_event,
+    [LWBTN_EVT_ONRELEASE] = prv_event_release,
+    [LWBTN_EVT_ONCLICK] = prv_event,
+    [LWBTN_EVT_KEEPALIVE] = NULL,
+};
+
+/* Keep input in specific state from start to end time, processing every millisecond */
+static void
+prv_run(uint8_t state, uint32_t start, uint32_t end) {
+    input = state;
+    for (uint32_t time = start; time < end; ++time) {
+        lwbtn_process_ex(&lw, time);
+    }
+}
+
+/* Check events of the button */
+static int
+prv_check(size_t idx, uint32_t onpress, uint32_t onrelease, uint32_t onclick, uint32_t keepalive) {
+    printf("Button %u: press: %u, release: %u, click: %u, keep alive: %u (%u)\r\n", (unsigned)idx,
+           (unsigned)evts[idx][LWBTN_EVT_ONPRESS], (unsigned)evts[idx][LWBTN_EVT_ONRELEASE],
+           (unsigned)evts[idx][LWBTN_EVT_ONCLICK], (unsigned)evts[idx][LWBTN_EVT_KEEPALIVE],
+           (unsigned)keepalive_cnt[idx]);
+    if (evts[idx][LWBTN_EVT_ONPRESS] != onpress || evts[idx][LWBTN_EVT_ONRELEASE] != onrelease
+        || evts[idx][LWBTN_EVT_ONCLICK] != onclick || evts[idx][LWBTN_EVT_KEEPALIVE] != keepalive) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_time_t deadline;
+
+    /* All events, press and click only, press and release only */
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_event);
+    if (!lwbtn_set_btn_evt_mask(&lw, &btns[1], LWBTN_EVT_MASK(LWBTN_EVT_ONPRESS) | LWBTN_EVT_MASK(LWBTN_EVT_ONCLICK))
+        || !lwbtn_set_btn_evt_mask(&lw, &btns[2],
+                                   LWBTN_EVT_MASK(LWBTN_EVT_ONPRESS) | LWBTN_EVT_MASK(LWBTN_EVT_ONRELEASE))
+        || lwbtn_set_btn_evt_mask(&lw, NULL, LWBTN_EVT_MASK_ALL)) {
+        printf("TEST FAILED... mask setup\r\n");
+        return -1;
+    }
+
+    /* Long press, then click */
+    prv_run(0, 0, 100);
+    prv_run(1, 100, 1100);
+    prv_run(0, 1100, 1200);
+    prv_run(1, 1200, 1300);
+    prv_run(0, 1300, 2000);
+    if (prv_check(0, 2, 2, 1, 9) != 0 || prv_check(1, 2, 0, 1, 0) != 0 || prv_check(2, 2, 2, 0, 0) != 0) {
+        printf("TEST FAILED... subscription masks\r\n");
+        return -1;
+    }
+
+    /* Handler table, with keep alive work skipped for button, that is not subscribed to it */
+    memset(evts, 0x00, sizeof(evts));
+    lwbtn_evt_fns_init(&lw, evt_fns);
+    lwbtn_set_btn_evt_mask(&lw, &btns[0], LWBTN_EVT_MASK_ALL & ~LWBTN_EVT_MASK(LWBTN_EVT_KEEPALIVE));
+    prv_run(1, 2000, 3000);
+    if (lwbtn_get_next_deadline(&lw, 3000, &deadline) != LWBTN_DEADLINE_IDLE) {
+        printf("TEST FAILED... pending keep alive work\r\n");
+        return -1;
+    }
+    prv_run(0, 3000, 4000);
+    if (prv_check(0, 1, 1, 0, 0) != 0 || prv_check(1, 1, 0, 0, 0) != 0 || prv_check(2, 1, 1, 0, 0) != 0
+        || keepalive_cnt[0] != 0) {
+        printf("TEST FAILED... event functions table\r\n");
+        return -1;
+    }
+    return 0;
+}
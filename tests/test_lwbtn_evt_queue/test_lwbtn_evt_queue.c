@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/* Test configuration */
+#define BTNS_CNT    16
+#define MAX_TIME_MS 60000
+#define MAX_EVENTS  50000
+#define QUEUE_SIZE  8
+
+/* Reference group with event function and group with event queue */
+static lwbtn_t ref_lw, q_lw;
+static lwbtn_btn_t ref_btns[BTNS_CNT], q_btns[BTNS_CNT];
+static lwbtn_evt_rec_t q_recs[64];
+
+/* Inputs and recorded events */
+static btn_test_input_t inputs[BTNS_CNT];
+static btn_test_rec_t ref_recs[MAX_EVENTS], q_evt_recs[MAX_EVENTS];
+static btn_test_evts_t ref_evts = {ref_recs, MAX_EVENTS, 0}, q_evts = {q_evt_recs, MAX_EVENTS, 0};
+static uint32_t time_current;
+
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    return inputs[btn - lw->btns].state;
+}
+
+static void
+prv_ref_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    test_evts_record(&ref_evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+}
+
+/* Read all events from the queue to the list */
+static void
+prv_queue_drain(void) {
+    lwbtn_evt_rec_t rec;
+    btn_test_rec_t* dut;
+
+    while (lwbtn_poll_event(&q_lw, &rec)) {
+        dut = test_evts_add(&q_evts, rec.time, rec.btn_idx, (lwbtn_evt_t)rec.evt);
+        if (dut != NULL) {
+            dut->keepalive_cnt = rec.keepalive_cnt;
+            dut->click_cnt = rec.click_cnt;
+        }
+    }
+}
+
+/* Compare event stream of the queue against reference event function */
+static int
+prv_test_stream(void) {
+    test_rand_init(0x2468ACE1);
+    test_inputs_init(inputs, BTNS_CNT, 100);
+    lwbtn_init_ex(&ref_lw, ref_btns, BTNS_CNT, prv_get_state, prv_ref_event);
+    lwbtn_init_ex(&q_lw, q_btns, BTNS_CNT, prv_get_state, NULL);
+    lwbtn_evt_queue_init(&q_lw, q_recs, sizeof(q_recs) / sizeof(q_recs[0]), LWBTN_EVT_QUEUE_DROP_NEWEST);
+
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        test_inputs_step(inputs, BTNS_CNT, 3000, NULL);
+        lwbtn_process_ex(&ref_lw, time_current);
+        lwbtn_process_ex(&q_lw, time_current);
+
+        /* Drain the queue only every few milliseconds */
+        if ((time_current % 7) == 0) {
+            prv_queue_drain();
+        }
+    }
+    prv_queue_drain();
+
+    printf("Reference events: %u, queue events: %u, dropped: %u\r\n", (unsigned)ref_evts.cnt, (unsigned)q_evts.cnt,
+           (unsigned)q_lw.evt_queue.dropped);
+    if (test_evts_compare(&ref_evts, &q_evts) != 0 || q_lw.evt_queue.dropped != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Keep single button pressed for 2 seconds without reading the queue.
+ * It generates on-press, 19 keep alive and on-release events
+ */
+static int
+prv_test_overflow(lwbtn_evt_queue_policy_t policy, uint16_t exp_cnt, uint16_t exp_last_keepalive,
+                  lwbtn_evt_t exp_last) {
+    lwbtn_evt_rec_t recs[QUEUE_SIZE], rec, last = {0};
+    uint16_t cnt = 0, last_keepalive = 0;
+
+    memset(q_btns, 0x00, sizeof(q_btns));
+    lwbtn_init_ex(&q_lw, q_btns, 1, prv_get_state, NULL);
+    lwbtn_evt_queue_init(&q_lw, recs, QUEUE_SIZE, policy);
+    for (time_current = 0; time_current < 2500; ++time_current) {
+        inputs[0].state = time_current >= 10 && time_current < 2010;
+        lwbtn_process_ex(&q_lw, time_current);
+    }
+    while (lwbtn_poll_event(&q_lw, &rec)) {
+        if (rec.evt == LWBTN_EVT_KEEPALIVE) {
+            last_keepalive = rec.keepalive_cnt;
+        }
+        last = rec;
+        ++cnt;
+    }
+    printf("Policy %u: read events: %u, dropped: %u\r\n", (unsigned)policy, (unsigned)cnt,
+           (unsigned)q_lw.evt_queue.dropped);
+    if (cnt != exp_cnt || last_keepalive != exp_last_keepalive || last.evt != exp_last
+        || cnt + q_lw.evt_queue.dropped != 21) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    if (prv_test_stream() != 0
+        /* First events are kept, release is lost */
+        || prv_test_overflow(LWBTN_EVT_QUEUE_DROP_NEWEST, QUEUE_SIZE, 7, LWBTN_EVT_KEEPALIVE) != 0
+        /* Newest events are kept, with one slot less */
+        || prv_test_overflow(LWBTN_EVT_QUEUE_DROP_OLDEST, QUEUE_SIZE - 1, 19, LWBTN_EVT_ONRELEASE) != 0
+        /* Keep alive events stop early, leaving space for release event */
+        || prv_test_overflow(LWBTN_EVT_QUEUE_COALESCE_KEEPALIVE, QUEUE_SIZE - 1, 5, LWBTN_EVT_ONRELEASE) != 0) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+    return 0;
+}
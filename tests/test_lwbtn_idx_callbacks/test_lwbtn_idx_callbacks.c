@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/**
+ * \brief           Group under test with its recorded events, used as user context
+ */
+typedef struct {
+    lwbtn_t lw;                /*!< Button group */
+    lwbtn_btn_t btns[8];       /*!< Buttons of the group */
+    btn_test_rec_t recs[5000]; /*!< Recorded events array */
+    btn_test_evts_t evts;      /*!< List of recorded events */
+} btn_test_group_t;
+
+/* Test configuration */
+#define BTNS_CNT    8
+#define MAX_TIME_MS 20000
+
+/* Reference group with button callbacks and group with index callbacks */
+static btn_test_group_t ref, idx;
+static btn_test_input_t inputs[BTNS_CNT];
+static uint32_t time_current;
+
+/* Attach records array to the list of recorded events */
+static void
+prv_group_init(btn_test_group_t* grp) {
+    grp->evts.recs = grp->recs;
+    grp->evts.size = sizeof(grp->recs) / sizeof(grp->recs[0]);
+    grp->evts.cnt = 0;
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    return inputs[btn - lw->btns].state;
+}
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    test_evts_add(&ref.evts, time_current, (uint16_t)(btn - lw->btns), evt);
+}
+
+static uint8_t
+prv_get_state_idx(void* user, uint16_t btn_idx) {
+    return user == &idx ? inputs[btn_idx].state : 0;
+}
+
+static void
+prv_event_idx(void* user, uint16_t btn_idx, lwbtn_evt_t evt) {
+    btn_test_group_t* grp = user;
+
+    test_evts_add(&grp->evts, time_current, btn_idx, evt);
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    test_rand_init(0x1234ABCD);
+    prv_group_init(&ref);
+    prv_group_init(&idx);
+
+    /* Button functions are optional, when index functions are used */
+    lwbtn_init_ex(&ref.lw, ref.btns, BTNS_CNT, prv_get_state, prv_event);
+    if (!lwbtn_init_ex(&idx.lw, idx.btns, BTNS_CNT, NULL, NULL)
+        || !lwbtn_idx_callbacks_init(&idx.lw, &idx, prv_get_state_idx, prv_event_idx)) {
+        printf("TEST FAILED... init\r\n");
+        return -1;
+    }
+
+    /* Same inputs for both groups */
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        test_inputs_step(inputs, BTNS_CNT, 1000, NULL);
+        lwbtn_process_ex(&ref.lw, time_current);
+        lwbtn_process_ex(&idx.lw, time_current);
+    }
+    printf("Events: %u, %u\r\n", (unsigned)ref.evts.cnt, (unsigned)idx.evts.cnt);
+    if (test_evts_compare(&ref.evts, &idx.evts) != 0) {
+        printf("TEST FAILED... index callbacks\r\n");
+        return -1;
+    }
+
+    /* Group without any get state function cannot be processed */
+    lwbtn_idx_callbacks_init(&idx.lw, &idx, NULL, prv_event_idx);
+    if (lwbtn_process_ex(&idx.lw, time_current)) {
+        printf("TEST FAILED... missing get state function\r\n");
+        return -1;
+    }
+    return 0;
+}
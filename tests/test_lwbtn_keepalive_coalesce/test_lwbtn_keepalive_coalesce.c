@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[1];
+static uint8_t input;
+static uint32_t keepalive_evts;
+static uint16_t keepalive_cnt, keepalive_periods;
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return input;
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    (void)lwobj;
+    if (evt == LWBTN_EVT_KEEPALIVE) {
+        ++keepalive_evts;
+        keepalive_cnt = lwbtn_keepalive_get_count(btn);
+        keepalive_periods = lwbtn_keepalive_get_evt_periods(btn);
+    }
+}
+
+/* Process the group at specific time and check keep alive events */
+static int
+prv_process_check(uint32_t time, uint32_t evts, uint16_t cnt, uint16_t periods) {
+    lwbtn_process_ex(&lw, time);
+    printf("Time %u: keep alive events: %u, counter: %u, periods: %u\r\n", (unsigned)time, (unsigned)keepalive_evts,
+           (unsigned)keepalive_cnt, (unsigned)keepalive_periods);
+    if (keepalive_evts != evts || keepalive_cnt != cnt || keepalive_periods != periods) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_init_ex(&lw, btns, 1, prv_get_state, prv_event);
+
+    /* On-press is detected at 21 ms */
+    lwbtn_process_ex(&lw, 0);
+    input = 1;
+    lwbtn_process_ex(&lw, 1);
+    lwbtn_process_ex(&lw, 21);
+
+    /* Stall of 10 periods is reported with single event, next one is back on period grid */
+    if (prv_process_check(1021, 1, 10, 10) != 0 || prv_process_check(1100, 1, 10, 10) != 0
+        || prv_process_check(1150, 2, 11, 1) != 0) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/* Test configuration */
+#define BTNS_CNT    3000
+#define WORKERS_CNT 3
+#define MAX_TIME_MS 5000
+#define MAX_EVENTS  200000
+
+/* Serial reference group and group processed in parallel */
+static lwbtn_t ref_lw, par_lw;
+static lwbtn_btn_t ref_btns[BTNS_CNT], par_btns[BTNS_CNT];
+static lwbtn_word_t par_active[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+static lwbtn_par_t par;
+
+/* Inputs and recorded events */
+static btn_test_input_t inputs[BTNS_CNT];
+static btn_test_rec_t ref_recs[MAX_EVENTS], par_recs[MAX_EVENTS];
+static btn_test_evts_t ref_evts = {ref_recs, MAX_EVENTS, 0}, par_evts = {par_recs, MAX_EVENTS, 0};
+static uint32_t time_current;
+
+/* Input edge is notified to parallel group */
+static void
+prv_input_edge(size_t idx, uint8_t state) {
+    lwbtn_notify_btn_change(&par_lw, &par_btns[idx]);
+    (void)state;
+}
+
+/* Input states are read by multiple threads at the same time */
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    return inputs[btn - lw->btns].state;
+}
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    btn_test_rec_t* rec;
+
+    rec = test_evts_record(lw == &ref_lw ? &ref_evts : &par_evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+    if (rec != NULL) {
+        rec->active = lwbtn_is_btn_active(btn);
+    }
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    test_rand_init(0x13572468);
+    test_inputs_init(inputs, BTNS_CNT, 100);
+    lwbtn_init_ex(&ref_lw, ref_btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_init_ex(&par_lw, par_btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_active_set_init(&par_lw, par_active);
+    if (!lwbtn_par_init(&par, &par_lw, WORKERS_CNT)) {
+        printf("Parallel init failed\r\n");
+        return -1;
+    }
+
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        test_inputs_step(inputs, BTNS_CNT, 3000, prv_input_edge);
+        lwbtn_process_ex(&ref_lw, time_current);
+        lwbtn_par_process(&par, time_current);
+    }
+    printf("Reference events: %u, parallel events: %u, shards: %u x %u buttons\r\n", (unsigned)ref_evts.cnt,
+           (unsigned)par_evts.cnt, (unsigned)par.shards_cnt, (unsigned)par.shard_btns);
+    lwbtn_par_deinit(&par);
+
+    /* Compare event streams */
+    if (test_evts_compare(&ref_evts, &par_evts) != 0) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+    return 0;
+}
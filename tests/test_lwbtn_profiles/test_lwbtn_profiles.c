@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/* Test configuration */
+#define BTNS_CNT 4
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[BTNS_CNT];
+static uint16_t keepalive_cnt[BTNS_CNT];
+static uint8_t input;
+
+/* Default timing and slow keep alive class with longer debounce */
+static lwbtn_profile_t profiles[] = {
+    LWBTN_PROFILE_DEFAULT,
+    LWBTN_PROFILE_DEFAULT,
+};
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return input;
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    if (evt == LWBTN_EVT_ONRELEASE) {
+        keepalive_cnt[btn - lwobj->btns] = btn->keepalive.cnt;
+    }
+}
+
+/* Press all buttons for specific time and check keep alive counters of both classes */
+static int
+prv_press(uint32_t start, uint32_t duration, uint16_t exp_default, uint16_t exp_slow) {
+    for (uint32_t time = start; time < start + duration + 500; ++time) {
+        input = time < start + duration;
+        lwbtn_process_ex(&lw, time);
+    }
+    printf("Keep alive counters: %u %u %u %u\r\n", (unsigned)keepalive_cnt[0], (unsigned)keepalive_cnt[1],
+           (unsigned)keepalive_cnt[2], (unsigned)keepalive_cnt[3]);
+    if (keepalive_cnt[0] != exp_default || keepalive_cnt[1] != exp_default || keepalive_cnt[2] != exp_slow
+        || keepalive_cnt[3] != exp_slow) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    profiles[1].time_debounce = 50;
+    profiles[1].time_keepalive_period = 250;
+
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_event);
+    if (!lwbtn_profiles_init(&lw, profiles, sizeof(profiles) / sizeof(profiles[0]))
+        || !lwbtn_set_btn_profile(&lw, &btns[2], 1) || !lwbtn_set_btn_profile(&lw, &btns[3], 1)
+        || lwbtn_set_btn_profile(&lw, &btns[0], 2)) {
+        printf("TEST FAILED... profile setup\r\n");
+        return -1;
+    }
+
+    /* Inputs must be inactive first, then on-press comes after 20 and 50 ms, keep alive every 100 and 250 ms */
+    lwbtn_process_ex(&lw, 0);
+    if (prv_press(1, 1000, 9, 3) != 0) {
+        printf("TEST FAILED... per-class timing\r\n");
+        return -1;
+    }
+
+    /* Retune the whole class with single write */
+    profiles[1].time_keepalive_period = 500;
+    if (prv_press(2000, 1000, 9, 1) != 0) {
+        printf("TEST FAILED... class retune\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/* Test configuration, buttons span more than one mask word */
+#define BTNS_CNT    (LWBTN_WORD_BITS + 8)
+#define MAX_TIME_MS 60000
+#define MAX_EVENTS  50000
+
+/* Reference group, with per-button states, and group with states pushed as a mask */
+static lwbtn_t ref_lw, mask_lw;
+static lwbtn_btn_t ref_btns[BTNS_CNT], mask_btns[BTNS_CNT];
+static lwbtn_word_t mask_active[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+static lwbtn_word_t mask_state_mask[LWBTN_STATE_MASK_WORDS(BTNS_CNT)];
+static lwbtn_word_t mask_input[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+
+/* Inputs and recorded events */
+static btn_test_input_t inputs[BTNS_CNT];
+static btn_test_rec_t ref_recs[MAX_EVENTS], mask_recs[MAX_EVENTS];
+static btn_test_evts_t ref_evts = {ref_recs, MAX_EVENTS, 0}, mask_evts = {mask_recs, MAX_EVENTS, 0};
+static uint32_t time_current;
+
+/* Input edge is set to reference button, and to the mask of the other group */
+static void
+prv_input_edge(size_t idx, uint8_t state) {
+    lwbtn_set_btn_state(&ref_btns[idx], state);
+    if (state) {
+        mask_input[idx / LWBTN_WORD_BITS] |= (lwbtn_word_t)1 << (idx % LWBTN_WORD_BITS);
+    } else {
+        mask_input[idx / LWBTN_WORD_BITS] &= ~((lwbtn_word_t)1 << (idx % LWBTN_WORD_BITS));
+    }
+}
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    test_evts_record(lw == &ref_lw ? &ref_evts : &mask_evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_time_t mask_deadline = 0;
+    lwbtn_deadline_t mask_res = LWBTN_DEADLINE_IDLE;
+    uint32_t mask_calls = 0;
+
+    test_rand_init(0x13572468);
+    test_inputs_init(inputs, BTNS_CNT, 100);
+    lwbtn_init_ex(&ref_lw, ref_btns, BTNS_CNT, NULL, prv_event);
+    lwbtn_init_ex(&mask_lw, mask_btns, BTNS_CNT, NULL, prv_event);
+    if (lwbtn_set_group_state_mask(&mask_lw, mask_input) || !lwbtn_active_set_init(&mask_lw, mask_active)
+        || !lwbtn_state_mask_init(&mask_lw, mask_state_mask, NULL)) {
+        printf("TEST FAILED... state mask setup\r\n");
+        return -1;
+    }
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        prv_input_edge(i, inputs[i].state);
+    }
+    lwbtn_set_group_state_mask(&mask_lw, mask_input);
+
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        uint8_t edge = test_inputs_step(inputs, BTNS_CNT, 5000, prv_input_edge);
+
+        lwbtn_process_ex(&ref_lw, time_current);
+
+        /* Mask is only pushed on input edge, group is processed then or when deadline is due */
+        if (edge) {
+            lwbtn_set_group_state_mask(&mask_lw, mask_input);
+        }
+        if (time_current == 0 || edge
+            || (mask_res == LWBTN_DEADLINE_PENDING && (int32_t)(time_current - mask_deadline) >= 0)) {
+            lwbtn_process_ex(&mask_lw, time_current);
+            mask_res = lwbtn_get_next_deadline(&mask_lw, time_current, &mask_deadline);
+            ++mask_calls;
+        }
+    }
+
+    printf("Reference events: %u, mask events: %u, mask calls: %u\r\n", (unsigned)ref_evts.cnt,
+           (unsigned)mask_evts.cnt, (unsigned)mask_calls);
+    if (test_evts_compare(&ref_evts, &mask_evts) != 0 || ref_evts.cnt == 0 || mask_calls >= MAX_TIME_MS) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+    return 0;
+}
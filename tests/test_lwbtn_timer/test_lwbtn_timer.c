@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/* Test configuration */
+#define BTNS_CNT    4
+#define MAX_TIME_MS 30000
+#define IDLE_TIME   (MAX_TIME_MS - 2000)
+#define MAX_EVENTS  20000
+#define RESET_TIME  3000
+
+/* Reference group, processed every millisecond, and timer driven group */
+static lwbtn_t ref_lw, tmr_lw;
+static lwbtn_btn_t ref_btns[BTNS_CNT], tmr_btns[BTNS_CNT];
+
+/* Inputs, recorded events and timer state */
+static btn_test_input_t inputs[BTNS_CNT];
+static btn_test_rec_t ref_recs[MAX_EVENTS], tmr_recs[MAX_EVENTS];
+static btn_test_evts_t ref_evts = {ref_recs, MAX_EVENTS, 0}, tmr_evts = {tmr_recs, MAX_EVENTS, 0};
+static uint32_t time_current, timer_calls, tmr_calls;
+static uint8_t timer_armed;
+static lwbtn_time_t timer_time;
+
+/* Advance simulated inputs for one millisecond, return `1` if any input changed */
+static uint8_t
+prv_inputs_step(void) {
+    uint8_t edge = 0;
+
+    if (time_current < IDLE_TIME) {
+        return test_inputs_step(inputs, BTNS_CNT, 2000, NULL);
+    }
+
+    /* Inputs are released and stay idle at the end of the test */
+    for (size_t i = 0; i < BTNS_CNT; ++i) {
+        edge |= inputs[i].state;
+        inputs[i].state = 0;
+    }
+    return edge;
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    return inputs[btn - lw->btns].state;
+}
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    test_evts_record(lw == &ref_lw ? &ref_evts : &tmr_evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+}
+
+static void
+prv_set_timer(struct lwbtn* lw, lwbtn_deadline_t status, lwbtn_time_t time) {
+    (void)lw;
+    timer_armed = status == LWBTN_DEADLINE_PENDING;
+    timer_time = time;
+    ++timer_calls;
+}
+
+/* Process reference group every millisecond, and timer driven group only on input edge or on timer expiry */
+static void
+prv_process(uint8_t edge) {
+    lwbtn_process_ex(&ref_lw, time_current);
+    if (time_current == 0 || edge || (timer_armed && (int32_t)(time_current - timer_time) >= 0)) {
+        lwbtn_process_ex(&tmr_lw, time_current);
+        ++tmr_calls;
+    }
+}
+
+/*
+ * Reset both groups while all buttons are released and timer is stopped, and press first button twice.
+ * Reset must arm the timer, so that released button receives its first inactive state before input edge.
+ */
+static int
+prv_test_reset_released(void) {
+    size_t tmr_evts_start = tmr_evts.cnt;
+    uint32_t onpress_cnt = 0;
+    uint8_t state, edge;
+
+    for (uint32_t start = time_current; time_current < start + RESET_TIME; ++time_current) {
+        uint32_t t = time_current - start;
+
+        state = (t >= 1000 && t < 1100) || (t >= 2000 && t < 2100);
+        edge = inputs[0].state != state;
+        inputs[0].state = state;
+        if (t == 500) {
+            lwbtn_reset(&ref_lw, NULL);
+            lwbtn_reset(&tmr_lw, NULL);
+            if (!timer_armed) {
+                printf("Timer not armed after reset\r\n");
+                return -1;
+            }
+        }
+        prv_process(edge);
+    }
+    for (size_t i = tmr_evts_start; i < tmr_evts.cnt; ++i) {
+        onpress_cnt += tmr_evts.recs[i].idx == 0 && tmr_evts.recs[i].evt == LWBTN_EVT_ONPRESS;
+    }
+    printf("On-press events after reset: %u\r\n", (unsigned)onpress_cnt);
+    return onpress_cnt == 2 && !timer_armed ? 0 : -1;
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    test_rand_init(0x13572468);
+    lwbtn_init_ex(&ref_lw, ref_btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_init_ex(&tmr_lw, tmr_btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_timer_init(&tmr_lw, prv_set_timer);
+
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        prv_process(prv_inputs_step());
+    }
+
+    printf("Reference events: %u, timer events: %u, process calls: %u, timer calls: %u\r\n", (unsigned)ref_evts.cnt,
+           (unsigned)tmr_evts.cnt, (unsigned)tmr_calls, (unsigned)timer_calls);
+    if (test_evts_compare(&ref_evts, &tmr_evts) != 0 || tmr_calls >= MAX_TIME_MS / 4 || timer_calls == 0) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+    /* Timer must be stopped once all buttons are idle */
+    if (timer_armed) {
+        printf("TEST FAILED... timer still armed when idle\r\n");
+        return -1;
+    }
+    if (prv_test_reset_released() != 0 || test_evts_compare(&ref_evts, &tmr_evts) != 0) {
+        printf("TEST FAILED... reset of released buttons\r\n");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+
+/* Test configuration */
+#define BTNS_CNT  4
+#define TEST_TIME 20000
+#define EVTS_MAX  2048
+
+typedef struct {
+    lwbtn_time_t time;
+    uint8_t btn_idx;
+    uint8_t evt;
+} test_evt_t;
+
+static lwbtn_t lw;
+static lwbtn_btn_t btns[BTNS_CNT];
+static lwbtn_word_t states[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+static lwbtn_word_t replay_states[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+static uint8_t live_buff[8192], input_buff[8192], replay_buff[8192];
+static lwbtn_trace_t live_trace, input_trace, replay_trace;
+static test_evt_t live_evts[EVTS_MAX], replay_evts[EVTS_MAX];
+static test_evt_t* evts;
+static size_t evts_cnt;
+static lwbtn_time_t now;
+
+/* Deterministic input, presses of different lengths, with contact bounce */
+static uint8_t
+prv_input(uint32_t idx, uint32_t time) {
+    uint32_t period = 700 + idx * 310, t = (time + idx * 97) % period;
+
+    if (t < 6) {
+        return t & 1;
+    }
+    return t < (uint32_t)(40 + idx * 180);
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    return prv_input((uint32_t)(btn - btns), now);
+}
+
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    if (evts_cnt < EVTS_MAX) {
+        evts[evts_cnt].time = now;
+        evts[evts_cnt].btn_idx = (uint8_t)(btn - lwobj->btns);
+        evts[evts_cnt].evt = (uint8_t)evt;
+    }
+    ++evts_cnt;
+}
+
+/* Event callback during replay, event has just been recorded with its time */
+static void
+prv_replay_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    now = replay_trace.time;
+    prv_event(lwobj, btn, evt);
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_trace_rec_t rec = {0};
+    size_t live_cnt, pos = 0, recs = 0;
+
+    /* Record live group, processed every millisecond */
+    evts = live_evts;
+    evts_cnt = 0;
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_event);
+    if (!lwbtn_trace_init(&live_trace, live_buff, sizeof(live_buff))
+        || !lwbtn_trace_attach(&lw, &live_trace, states)) {
+        printf("TEST FAILED... trace setup\r\n");
+        return -1;
+    }
+    for (now = 0; now < TEST_TIME; ++now) {
+        lwbtn_process_ex(&lw, now);
+    }
+    rec.time = TEST_TIME;
+    rec.type = LWBTN_TRACE_REC_MARK;
+    lwbtn_trace_write(&live_trace, &rec);
+    live_cnt = evts_cnt;
+    printf("Live: %u events, trace of %u bytes\r\n", (unsigned)live_cnt, (unsigned)live_trace.len);
+    if (live_trace.overflow || live_cnt == 0 || live_cnt > EVTS_MAX) {
+        printf("TEST FAILED... live recording\r\n");
+        return -1;
+    }
+
+    /* Read back and keep input records only, as imported from captures */
+    memset(&rec, 0x00, sizeof(rec));
+    lwbtn_trace_init(&input_trace, input_buff, sizeof(input_buff));
+    while (lwbtn_trace_read(live_buff, live_trace.len, &pos, &rec)) {
+        if (rec.type != LWBTN_TRACE_REC_EVT) {
+            lwbtn_trace_write(&input_trace, &rec);
+        }
+        ++recs;
+    }
+    if (pos != live_trace.len || rec.type != LWBTN_TRACE_REC_MARK || rec.time != TEST_TIME || input_trace.overflow) {
+        printf("TEST FAILED... trace read\r\n");
+        return -1;
+    }
+
+    /* Replay inputs to fresh group, with recorder attached */
+    memset(btns, 0x00, sizeof(btns));
+    evts = replay_evts;
+    evts_cnt = 0;
+    lwbtn_init_ex(&lw, btns, BTNS_CNT, prv_get_state, prv_replay_event);
+    lwbtn_trace_init(&replay_trace, replay_buff, sizeof(replay_buff));
+    lwbtn_trace_attach(&lw, &replay_trace, states);
+    if (!lwbtn_trace_replay(&lw, input_buff, input_trace.len, replay_states)) {
+        printf("TEST FAILED... replay\r\n");
+        return -1;
+    }
+    lwbtn_trace_write(&replay_trace, &rec);
+    printf("Replay: %u events out of %u records, trace of %u bytes\r\n", (unsigned)evts_cnt, (unsigned)recs,
+           (unsigned)replay_trace.len);
+    if (evts_cnt != live_cnt || memcmp(live_evts, replay_evts, live_cnt * sizeof(live_evts[0])) != 0) {
+        printf("TEST FAILED... replayed events\r\n");
+        return -1;
+    }
+    if (replay_trace.len != live_trace.len || memcmp(live_buff, replay_buff, live_trace.len) != 0) {
+        printf("TEST FAILED... replayed trace\r\n");
+        return -1;
+    }
+    return 0;
+}
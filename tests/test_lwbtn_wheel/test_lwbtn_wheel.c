@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwbtn/lwbtn.h"
+#include "test.h"
+#include "test_fixture.h"
+
+/* Test configuration, wheel is shorter than click and keep alive timeouts */
+#define BTNS_CNT    1000
+#define SLOTS_CNT   64
+#define MAX_TIME_MS 10000
+#define MAX_EVENTS  200000
+
+/* Reference group, processing all buttons every millisecond, and wheel group, processed on demand */
+static lwbtn_t ref_lw, wh_lw;
+static lwbtn_btn_t ref_btns[BTNS_CNT], wh_btns[BTNS_CNT];
+static lwbtn_word_t wh_active[LWBTN_BITMAP_WORDS(BTNS_CNT)];
+static uint16_t wh_slots[SLOTS_CNT];
+static lwbtn_wheel_node_t wh_nodes[BTNS_CNT];
+
+/* Inputs and recorded events */
+static btn_test_input_t inputs[BTNS_CNT];
+static btn_test_rec_t ref_recs[MAX_EVENTS], wh_recs[MAX_EVENTS];
+static btn_test_evts_t ref_evts = {ref_recs, MAX_EVENTS, 0}, wh_evts = {wh_recs, MAX_EVENTS, 0};
+static uint32_t time_current, wh_get_state_calls;
+
+/* Input edge is notified to wheel group */
+static void
+prv_input_edge(size_t idx, uint8_t state) {
+    lwbtn_notify_btn_change(&wh_lw, &wh_btns[idx]);
+    (void)state;
+}
+
+static uint8_t
+prv_get_state(struct lwbtn* lw, struct lwbtn_btn* btn) {
+    wh_get_state_calls += lw == &wh_lw;
+    return inputs[btn - lw->btns].state;
+}
+
+static void
+prv_event(struct lwbtn* lw, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    test_evts_record(lw == &ref_lw ? &ref_evts : &wh_evts, time_current, (uint16_t)(btn - lw->btns), btn, evt);
+}
+
+/**
+ * \brief           Test function
+ */
+int
+test_run(void) {
+    lwbtn_time_t ref_deadline = 0, wh_deadline = 0;
+    lwbtn_deadline_t ref_res, wh_res = LWBTN_DEADLINE_IDLE;
+    uint32_t wh_calls = 0;
+
+    test_rand_init(0x2468ACE1);
+    test_inputs_init(inputs, BTNS_CNT, 1000);
+    lwbtn_init_ex(&ref_lw, ref_btns, BTNS_CNT, prv_get_state, prv_event);
+    lwbtn_init_ex(&wh_lw, wh_btns, BTNS_CNT, prv_get_state, prv_event);
+    if (lwbtn_wheel_init(&wh_lw, wh_slots, SLOTS_CNT, wh_nodes) || !lwbtn_active_set_init(&wh_lw, wh_active)
+        || lwbtn_wheel_init(&wh_lw, wh_slots, SLOTS_CNT - 1, wh_nodes)
+        || !lwbtn_wheel_init(&wh_lw, wh_slots, SLOTS_CNT, wh_nodes)) {
+        printf("TEST FAILED... wheel setup\r\n");
+        return -1;
+    }
+
+    for (time_current = 0; time_current < MAX_TIME_MS; ++time_current) {
+        uint8_t edge = test_inputs_step(inputs, BTNS_CNT, 20000, prv_input_edge);
+
+        lwbtn_process_ex(&ref_lw, time_current);
+
+        /* Wheel group is only processed on input edge or when deadline is due */
+        if (time_current == 0 || edge
+            || (wh_res == LWBTN_DEADLINE_PENDING && (int32_t)(time_current - wh_deadline) >= 0)) {
+            lwbtn_process_ex(&wh_lw, time_current);
+            ++wh_calls;
+
+            /* Deadline from the wheel must match full scan of the reference group */
+            wh_res = lwbtn_get_next_deadline(&wh_lw, time_current, &wh_deadline);
+            ref_res = lwbtn_get_next_deadline(&ref_lw, time_current, &ref_deadline);
+            if (wh_res != ref_res || (wh_res == LWBTN_DEADLINE_PENDING && wh_deadline != ref_deadline)) {
+                printf("TEST FAILED... deadline mismatch at time %u: %u/%u vs %u/%u\r\n", (unsigned)time_current,
+                       (unsigned)wh_res, (unsigned)wh_deadline, (unsigned)ref_res, (unsigned)ref_deadline);
+                return -1;
+            }
+        }
+    }
+
+    printf("Reference events: %u, wheel events: %u, wheel calls: %u, get state calls: %u\r\n",
+           (unsigned)ref_evts.cnt, (unsigned)wh_evts.cnt, (unsigned)wh_calls, (unsigned)wh_get_state_calls);
+    if (test_evts_compare(&ref_evts, &wh_evts) != 0 || ref_evts.cnt >= MAX_EVENTS
+        || wh_get_state_calls >= (uint32_t)BTNS_CNT * wh_calls / 10) {
+        printf("TEST FAILED...\r\n");
+        return -1;
+    }
+    return 0;
+}
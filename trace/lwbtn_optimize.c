@@ -0,0 +1,539 @@
+/**
+ * \file            lwbtn_optimize.c
+ * \brief           Host tool to find debounce and click timing for labeled traces
+ *
+ * Usage: lwbtn_optimize [options] <trace.bin> [--labels labels.csv] [<trace.bin> ...]
+ *
+ * Every candidate set of timing parameters replays all traces through its own group,
+ * with parameters written to the dynamic fields of the buttons. Events are compared against labels,
+ * on-press, on-release and on-click events by default:
+ *
+ * - Event records of the trace are the labels, unless labels are given with `--labels` after the trace,
+ *          as `time,button,event` CSV, the same as printed by `lwbtn_trace replay`
+ * - Label and event of the same button and type match, when they are not further than the window apart
+ * - Unmatched label is missed event, unmatched event is spurious event
+ *
+ * Candidates with least errors are reported first, then the ones with lowest mean latency.
+ *
+ * Options:
+ *
+ * - --press, --release, --click-min, --click-max, --multi-max lo:hi:step: Parameter range, in milliseconds
+ * - --window ms: Maximum distance between label and event, default `100`
+ * - --keepalive: Compare keep alive events too
+ * - --threads n: Number of worker threads, default is number of processors
+ * - --top n: Number of reported candidates, default `10`
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "lwbtn/lwbtn.h"
+
+/* Number of optimized parameters */
+#define OPT_PARAMS   5
+/* Candidates taken by worker at once */
+#define OPT_CHUNK    16
+/* Maximal number of traces */
+#define OPT_TRACES   64
+
+/**
+ * \brief           Event of the button, label or replayed
+ */
+typedef struct {
+    lwbtn_time_t time; /*!< Event time in milliseconds */
+    uint16_t btn_idx;  /*!< Button index */
+    uint8_t evt;       /*!< Event type */
+} opt_evt_t;
+
+/**
+ * \brief           Loaded trace
+ */
+typedef struct {
+    uint8_t* data;     /*!< Trace data with input and time mark records only */
+    size_t len;        /*!< Length of trace data */
+    uint16_t btns_cnt; /*!< Number of buttons */
+    opt_evt_t* labels; /*!< Labels in time order */
+    size_t labels_cnt; /*!< Number of labels */
+} opt_trace_t;
+
+/**
+ * \brief           Result of one candidate
+ */
+typedef struct {
+    uint16_t params[OPT_PARAMS]; /*!< Parameter values */
+    unsigned long missed;        /*!< Number of labels without event */
+    unsigned long spurious;      /*!< Number of events without label */
+    double latency;              /*!< Mean latency of matched events in milliseconds */
+} opt_result_t;
+
+/**
+ * \brief           Worker context. Group is first member, to get context in event callback
+ */
+typedef struct {
+    lwbtn_t lw;                  /*!< Group */
+    lwbtn_btn_t* btns;           /*!< Buttons */
+    lwbtn_word_t* states;        /*!< Last recorded input states */
+    lwbtn_word_t* replay_states; /*!< Replayed input states */
+    lwbtn_trace_t rec;           /*!< Recorder of replayed events */
+    opt_evt_t* evts;             /*!< Decoded events */
+    uint8_t* matched;            /*!< Matched flags of decoded events */
+    size_t evts_size;            /*!< Size of decoded events memory */
+    pthread_t thread;            /*!< Worker thread */
+} opt_worker_t;
+
+static const char* param_names[OPT_PARAMS] = {"press", "release", "click-min", "click-max", "multi-max"};
+static uint16_t param_ranges[OPT_PARAMS][3] = {
+    {0, 50, 5}, {0, 50, 5}, {0, 100, 20}, {200, 600, 100}, {200, 600, 100},
+};
+static const char* evt_names[] = {"onpress", "onrelease", "onclick", "keepalive"};
+
+static opt_trace_t traces[OPT_TRACES];
+static size_t traces_cnt;
+static uint16_t btns_max;
+static opt_result_t* results;
+static size_t candidates_cnt, candidate_next;
+static pthread_mutex_t candidate_lock = PTHREAD_MUTEX_INITIALIZER;
+static long window = 100;
+static uint8_t evt_compare_mask = (1U << LWBTN_EVT_ONPRESS) | (1U << LWBTN_EVT_ONRELEASE) | (1U << LWBTN_EVT_ONCLICK);
+
+/* Events are taken from the recorded trace, after replay */
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    (void)lwobj;
+    (void)btn;
+    (void)evt;
+}
+
+/* Input states are taken from the replayed trace */
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return 0;
+}
+
+/**
+ * \brief           Get parameter values of the candidate
+ * \param[in]       index: Candidate index
+ * \param[out]      params: Parameter values
+ */
+static void
+prv_candidate(size_t index, uint16_t* params) {
+    for (size_t i = 0; i < OPT_PARAMS; ++i) {
+        size_t cnt = (size_t)(param_ranges[i][1] - param_ranges[i][0]) / param_ranges[i][2] + 1;
+
+        params[i] = (uint16_t)(param_ranges[i][0] + (index % cnt) * param_ranges[i][2]);
+        index /= cnt;
+    }
+}
+
+/**
+ * \brief           Get signed time difference, for any width of time type
+ * \param[in]       time: Time
+ * \param[in]       ref: Reference time
+ * \return          Milliseconds from reference time to time, negative when time is before reference time
+ */
+static long
+prv_time_diff(lwbtn_time_t time, lwbtn_time_t ref) {
+    lwbtn_time_t diff = (lwbtn_time_t)(time - ref);
+
+    return diff <= (lwbtn_time_t)(~(lwbtn_time_t)0 / 2U) ? (long)diff : -(long)(lwbtn_time_t)(ref - time);
+}
+
+/**
+ * \brief           Add event to the array, memory grows when full
+ * \param[in,out]   evts: Pointer to events memory
+ * \param[in]       cnt: Number of events in the memory
+ * \param[in,out]   size: Size of events memory
+ * \param[in]       evt: Event to add
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_evt_add(opt_evt_t** evts, size_t cnt, size_t* size, const opt_evt_t* evt) {
+    if (cnt >= *size) {
+        size_t new_size = *size > 0 ? *size * 2 : 1024;
+        opt_evt_t* mem = realloc(*evts, new_size * sizeof(**evts));
+
+        if (mem == NULL) {
+            return 0;
+        }
+        *evts = mem;
+        *size = new_size;
+    }
+    (*evts)[cnt] = *evt;
+    return 1;
+}
+
+/**
+ * \brief           Replay one trace with candidate parameters and compare events against labels
+ * \param[in]       w: Worker context
+ * \param[in]       trace: Trace to replay
+ * \param[in,out]   res: Result to update. Latency is accumulated as sum
+ * \param[out]      matched_cnt: Number of matched events, added to the current value
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_evaluate(opt_worker_t* w, const opt_trace_t* trace, opt_result_t* res, unsigned long* matched_cnt) {
+    lwbtn_trace_rec_t rec = {0};
+    size_t pos = 0, cnt = 0, first = 0;
+
+    /* Repeat with larger memory, when recording does not fit */
+    do {
+        if (w->rec.overflow) {
+            uint8_t* buff = realloc(w->rec.buff, w->rec.size * 2);
+
+            if (buff == NULL) {
+                return 0;
+            }
+            w->rec.buff = buff;
+            w->rec.size *= 2;
+        }
+        lwbtn_trace_init(&w->rec, w->rec.buff, w->rec.size);
+
+        memset(w->btns, 0x00, trace->btns_cnt * sizeof(*w->btns));
+        lwbtn_init_ex(&w->lw, w->btns, trace->btns_cnt, prv_get_state, prv_event);
+        for (size_t i = 0; i < trace->btns_cnt; ++i) {
+            w->btns[i].time_debounce = res->params[0];
+            w->btns[i].time_debounce_release = res->params[1];
+            w->btns[i].time_click_pressed_min = res->params[2];
+            w->btns[i].time_click_pressed_max = res->params[3];
+            w->btns[i].time_click_multi_max = res->params[4];
+        }
+        lwbtn_trace_attach(&w->lw, &w->rec, w->states);
+        if (!lwbtn_trace_replay(&w->lw, trace->data, trace->len, w->replay_states)) {
+            return 0;
+        }
+    } while (w->rec.overflow);
+
+    /* Decode compared events */
+    while (lwbtn_trace_read(w->rec.buff, w->rec.len, &pos, &rec)) {
+        if (rec.type == LWBTN_TRACE_REC_EVT && (evt_compare_mask & (1U << rec.val))) {
+            opt_evt_t evt = {rec.time, rec.btn_idx, rec.val};
+
+            if (!prv_evt_add(&w->evts, cnt++, &w->evts_size, &evt)) {
+                return 0;
+            }
+        }
+    }
+    if ((w->matched = realloc(w->matched, w->evts_size)) == NULL) {
+        return 0;
+    }
+    memset(w->matched, 0x00, cnt);
+
+    /* Match every label with the earliest unmatched event in the window, both are in time order */
+    for (size_t l = 0; l < trace->labels_cnt; ++l) {
+        const opt_evt_t* label = &trace->labels[l];
+        size_t e;
+
+        while (first < cnt && prv_time_diff(label->time, w->evts[first].time) > window) {
+            ++first;
+        }
+        for (e = first; e < cnt; ++e) {
+            if (prv_time_diff(w->evts[e].time, label->time) > window) {
+                e = cnt;
+                break;
+            }
+            if (!w->matched[e] && w->evts[e].btn_idx == label->btn_idx && w->evts[e].evt == label->evt) {
+                break;
+            }
+        }
+        if (e < cnt) {
+            w->matched[e] = 1;
+            res->latency += (double)prv_time_diff(w->evts[e].time, label->time);
+            ++*matched_cnt;
+        } else {
+            ++res->missed;
+        }
+    }
+    for (size_t e = 0; e < cnt; ++e) {
+        res->spurious += !w->matched[e];
+    }
+    return 1;
+}
+
+/**
+ * \brief           Worker thread, evaluates candidates until none is left
+ * \param[in]       arg: Worker context
+ * \return          `NULL` on success, non-`NULL` on failure
+ */
+static void*
+prv_worker(void* arg) {
+    opt_worker_t* w = arg;
+
+    for (;;) {
+        size_t start, end;
+
+        pthread_mutex_lock(&candidate_lock);
+        start = candidate_next;
+        candidate_next = start + OPT_CHUNK < candidates_cnt ? start + OPT_CHUNK : candidates_cnt;
+        end = candidate_next;
+        pthread_mutex_unlock(&candidate_lock);
+        if (start >= end) {
+            break;
+        }
+
+        for (size_t c = start; c < end; ++c) {
+            opt_result_t* res = &results[c];
+            unsigned long matched_cnt = 0;
+
+            prv_candidate(c, res->params);
+            for (size_t t = 0; t < traces_cnt; ++t) {
+                if (!prv_evaluate(w, &traces[t], res, &matched_cnt)) {
+                    return w;
+                }
+            }
+            res->latency = matched_cnt > 0 ? res->latency / (double)matched_cnt : 0;
+        }
+    }
+    return NULL;
+}
+
+/* Compare events by time */
+static int
+prv_evt_cmp(const void* a, const void* b) {
+    long diff = prv_time_diff(((const opt_evt_t*)a)->time, ((const opt_evt_t*)b)->time);
+
+    return diff < 0 ? -1 : (diff > 0 ? 1 : 0);
+}
+
+/**
+ * \brief           Load trace and its labels
+ * \param[in]       path: Trace file path
+ * \param[in]       labels_path: Labels file path, `NULL` to take labels from event records of the trace
+ * \param[out]      trace: Trace to load to
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_load(const char* path, const char* labels_path, opt_trace_t* trace) {
+    FILE* file = fopen(path, "rb");
+    lwbtn_trace_rec_t rec = {0};
+    lwbtn_trace_t inputs;
+    uint8_t* data;
+    size_t len, pos = 0, labels_size = 0;
+    long size;
+
+    if (file == NULL) {
+        return 0;
+    }
+    if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0
+        || (data = malloc((size_t)size + 1)) == NULL) {
+        fclose(file);
+        return 0;
+    }
+    len = fread(data, 1, (size_t)size, file);
+    fclose(file);
+
+    /* Keep inputs and time marks for replay, events are labels */
+    lwbtn_trace_init(&inputs, malloc(len + 1), len + 1);
+    while (lwbtn_trace_read(data, len, &pos, &rec)) {
+        if (rec.type == LWBTN_TRACE_REC_EVT) {
+            opt_evt_t evt = {rec.time, rec.btn_idx, rec.val};
+
+            if (labels_path == NULL && (evt_compare_mask & (1U << rec.val))
+                && !prv_evt_add(&trace->labels, trace->labels_cnt++, &labels_size, &evt)) {
+                break;
+            }
+        } else {
+            lwbtn_trace_write(&inputs, &rec);
+        }
+        if (rec.type != LWBTN_TRACE_REC_MARK && rec.btn_idx >= trace->btns_cnt) {
+            trace->btns_cnt = (uint16_t)(rec.btn_idx + 1);
+        }
+    }
+    free(data);
+    trace->data = inputs.buff;
+    trace->len = inputs.len;
+    if (trace->data == NULL || pos != len) {
+        return 0;
+    }
+
+    /* Labels from CSV, as printed by replay */
+    if (labels_path != NULL) {
+        char line[256], name[32];
+        unsigned long time;
+        unsigned btn_idx;
+
+        if ((file = fopen(labels_path, "r")) == NULL) {
+            return 0;
+        }
+        while (fgets(line, sizeof(line), file) != NULL) {
+            if (sscanf(line, "%lu,%u,%31[a-z]", &time, &btn_idx, name) != 3) {
+                continue;
+            }
+            for (uint8_t e = 0; e < sizeof(evt_names) / sizeof(evt_names[0]); ++e) {
+                opt_evt_t evt = {(lwbtn_time_t)time, (uint16_t)btn_idx, e};
+
+                if (strcmp(name, evt_names[e]) == 0 && (evt_compare_mask & (1U << e))
+                    && !prv_evt_add(&trace->labels, trace->labels_cnt++, &labels_size, &evt)) {
+                    fclose(file);
+                    return 0;
+                }
+            }
+        }
+        fclose(file);
+        qsort(trace->labels, trace->labels_cnt, sizeof(*trace->labels), prv_evt_cmp);
+    }
+    if (trace->btns_cnt > btns_max) {
+        btns_max = trace->btns_cnt;
+    }
+    return 1;
+}
+
+/* Compare results, least errors first, then lowest latency */
+static int
+prv_result_cmp(const void* a, const void* b) {
+    const opt_result_t *ra = a, *rb = b;
+    unsigned long ea = ra->missed + ra->spurious, eb = rb->missed + rb->spurious;
+
+    if (ea != eb) {
+        return ea < eb ? -1 : 1;
+    }
+    if (ra->latency != rb->latency) {
+        return ra->latency < rb->latency ? -1 : 1;
+    }
+    return 0;
+}
+
+int
+main(int argc, char* argv[]) {
+    const char* files[OPT_TRACES][2];
+    long threads_cnt = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t top = 10;
+    opt_worker_t* workers;
+    struct timespec start, end;
+    double seconds;
+    int res = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        uint8_t param = 0;
+
+        while (param < OPT_PARAMS && (strncmp(argv[i], "--", 2) != 0 || strcmp(&argv[i][2], param_names[param]) != 0)) {
+            ++param;
+        }
+        if (param < OPT_PARAMS && i + 1 < argc) {
+            unsigned lo, hi, step;
+
+            if (sscanf(argv[++i], "%u:%u:%u", &lo, &hi, &step) != 3 || step == 0 || lo > hi || hi > 0xFFFFU) {
+                printf("Invalid range %s\r\n", argv[i]);
+                return -1;
+            }
+            param_ranges[param][0] = (uint16_t)lo;
+            param_ranges[param][1] = (uint16_t)hi;
+            param_ranges[param][2] = (uint16_t)step;
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            window = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads_cnt = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            top = (size_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--keepalive") == 0) {
+            evt_compare_mask |= 1U << LWBTN_EVT_KEEPALIVE;
+        } else if (traces_cnt < OPT_TRACES && argv[i][0] != '-') {
+            /* Labels file can follow the trace */
+            files[traces_cnt][0] = argv[i];
+            files[traces_cnt][1] = NULL;
+            if (i + 2 < argc && strcmp(argv[i + 1], "--labels") == 0) {
+                files[traces_cnt][1] = argv[i + 2];
+                i += 2;
+            }
+            ++traces_cnt;
+        } else {
+            printf("Unknown argument %s\r\n", argv[i]);
+            return -1;
+        }
+    }
+    if (traces_cnt == 0) {
+        printf("Usage: %s [--press|--release|--click-min|--click-max|--multi-max lo:hi:step] [--window ms]\r\n",
+               argv[0]);
+        printf("       [--keepalive] [--threads n] [--top n] <trace.bin> [--labels labels.csv] ...\r\n");
+        return -1;
+    }
+
+    /* Load after all options, as they select compared events */
+    for (size_t t = 0; t < traces_cnt; ++t) {
+        if (!prv_load(files[t][0], files[t][1], &traces[t])) {
+            printf("Cannot load trace %s\r\n", files[t][0]);
+            return -1;
+        }
+    }
+
+    /* Every combination of parameter values */
+    candidates_cnt = 1;
+    for (size_t i = 0; i < OPT_PARAMS; ++i) {
+        candidates_cnt *= (size_t)(param_ranges[i][1] - param_ranges[i][0]) / param_ranges[i][2] + 1;
+    }
+    if (threads_cnt < 1) {
+        threads_cnt = 1;
+    }
+    results = calloc(candidates_cnt, sizeof(*results));
+    workers = calloc((size_t)threads_cnt, sizeof(*workers));
+    if (results == NULL || workers == NULL) {
+        printf("Out of memory\r\n");
+        return -1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (long i = 0; i < threads_cnt; ++i) {
+        opt_worker_t* w = &workers[i];
+
+        w->btns = calloc(btns_max + 1U, sizeof(*w->btns));
+        w->states = calloc(LWBTN_BITMAP_WORDS(btns_max) + 1, sizeof(*w->states));
+        w->replay_states = calloc(LWBTN_BITMAP_WORDS(btns_max) + 1, sizeof(*w->replay_states));
+        w->rec.size = 4096;
+        w->rec.buff = malloc(w->rec.size);
+        if (w->btns == NULL || w->states == NULL || w->replay_states == NULL || w->rec.buff == NULL
+            || pthread_create(&w->thread, NULL, prv_worker, w) != 0) {
+            printf("Cannot start worker\r\n");
+            return -1;
+        }
+    }
+    for (long i = 0; i < threads_cnt; ++i) {
+        void* ret;
+
+        pthread_join(workers[i].thread, &ret);
+        res |= ret != NULL;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (res) {
+        printf("Evaluation failed\r\n");
+        return -1;
+    }
+    seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+
+    /* Invalid click ranges are reported last */
+    for (size_t c = 0; c < candidates_cnt; ++c) {
+        if (results[c].params[2] > results[c].params[3]) {
+            results[c].missed = results[c].spurious = (unsigned long)-1 / 2;
+        }
+    }
+    qsort(results, candidates_cnt, sizeof(*results), prv_result_cmp);
+
+    fprintf(stderr, "Evaluated %lu candidates on %lu traces in %.3f s with %ld threads, %.0f candidates per second\n",
+            (unsigned long)candidates_cnt, (unsigned long)traces_cnt, seconds, threads_cnt,
+            seconds > 0 ? (double)candidates_cnt / seconds : 0.0);
+    printf("press,release,click_min,click_max,multi_max,missed,spurious,latency_ms\n");
+    for (size_t c = 0; c < top && c < candidates_cnt; ++c) {
+        printf("%u,%u,%u,%u,%u,%lu,%lu,%.2f\n", (unsigned)results[c].params[0], (unsigned)results[c].params[1],
+               (unsigned)results[c].params[2], (unsigned)results[c].params[3], (unsigned)results[c].params[4],
+               results[c].missed, results[c].spurious, results[c].latency);
+    }
+
+    for (long i = 0; i < threads_cnt; ++i) {
+        free(workers[i].btns);
+        free(workers[i].states);
+        free(workers[i].replay_states);
+        free(workers[i].rec.buff);
+        free(workers[i].evts);
+        free(workers[i].matched);
+    }
+    for (size_t t = 0; t < traces_cnt; ++t) {
+        free(traces[t].data);
+        free(traces[t].labels);
+    }
+    free(workers);
+    free(results);
+    return 0;
+}
@@ -0,0 +1,499 @@
+/**
+ * \file            lwbtn_trace.c
+ * \brief           Host tool to import, dump and replay button traces
+ *
+ * Usage: lwbtn_trace <command> ...
+ *
+ * - vcd <in.vcd> <out.bin> [--active-low]: Import 1-bit wires of value change dump,
+ *          button index is the order of wire declaration
+ * - csv <in.csv> <out.bin> [--active-low] [--samplerate HZ]: Import sigrok-style CSV,
+ *          one column per button, optional `Time` column in seconds.
+ *          Sample rate is taken from `; Samplerate:` comment, unless set from the command line
+ * - dump <in.bin>: Print all records as CSV
+ * - replay <in.bin> [--record out.bin]: Replay trace through the group and print events as CSV.
+ *          Group has as many buttons as the largest button index in the trace
+ *
+ * Imported input states are sampled with millisecond resolution, only last change
+ * of the button in every millisecond is kept. Capture end is written as time mark record.
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwbtn/lwbtn.h"
+
+/* Maximal number of imported channels */
+#define TRACE_CHANNELS_MAX 1024U
+
+/**
+ * \brief           Imported channel
+ */
+typedef struct {
+    char id[32];    /*!< VCD identifier code or CSV column name */
+    uint8_t state;  /*!< Last state written to the trace */
+    uint8_t sample; /*!< Last sampled state in current millisecond */
+} trace_channel_t;
+
+static lwbtn_trace_t trace;
+static trace_channel_t channels[TRACE_CHANNELS_MAX];
+static size_t channels_cnt;
+static uint8_t active_low;
+static uint64_t sample_ms;
+
+static const char* evt_names[] = {"onpress", "onrelease", "onclick", "keepalive"};
+
+/**
+ * \brief           Write record to the trace, memory grows when full
+ * \param[in]       rec: Record to write
+ */
+static void
+prv_write(const lwbtn_trace_rec_t* rec) {
+    while (!lwbtn_trace_write(&trace, rec)) {
+        size_t size = trace.size > 0 ? trace.size * 2 : 4096;
+        uint8_t* buff = realloc(trace.buff, size);
+
+        if (buff == NULL) {
+            printf("Out of memory\r\n");
+            exit(-1);
+        }
+        trace.buff = buff;
+        trace.size = size;
+        trace.overflow = 0;
+    }
+}
+
+/**
+ * \brief           Write input changes sampled in current millisecond
+ */
+static void
+prv_flush(void) {
+    for (size_t i = 0; i < channels_cnt; ++i) {
+        if (channels[i].sample != channels[i].state) {
+            lwbtn_trace_rec_t rec = {0};
+
+            rec.time = (lwbtn_time_t)sample_ms;
+            rec.btn_idx = (uint16_t)i;
+            rec.type = LWBTN_TRACE_REC_INPUT;
+            rec.val = channels[i].sample;
+            prv_write(&rec);
+            channels[i].state = channels[i].sample;
+        }
+    }
+}
+
+/**
+ * \brief           Sample input of the channel
+ * \param[in]       ch: Channel index
+ * \param[in]       time_ms: Time of the change in milliseconds, rounded up
+ * \param[in]       level: Logic level of the input
+ */
+static void
+prv_sample(size_t ch, uint64_t time_ms, uint8_t level) {
+    if (time_ms > sample_ms) {
+        prv_flush();
+        sample_ms = time_ms;
+    }
+    channels[ch].sample = (uint8_t)(level ^ active_low);
+}
+
+/**
+ * \brief           Write pending changes and time mark of capture end
+ * \param[in]       end_ms: Capture end time in milliseconds
+ */
+static void
+prv_finish(uint64_t end_ms) {
+    lwbtn_trace_rec_t rec = {0};
+
+    prv_flush();
+    rec.time = (lwbtn_time_t)(end_ms > sample_ms ? end_ms : sample_ms);
+    rec.type = LWBTN_TRACE_REC_MARK;
+    prv_write(&rec);
+}
+
+/**
+ * \brief           Add new channel, all inputs are inactive before capture starts
+ * \param[in]       id: Channel identifier
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_channel_add(const char* id) {
+    if (channels_cnt >= TRACE_CHANNELS_MAX) {
+        return 0;
+    }
+    snprintf(channels[channels_cnt].id, sizeof(channels[0].id), "%.*s", (int)sizeof(channels[0].id) - 1, id);
+    channels[channels_cnt].state = channels[channels_cnt].sample = active_low;
+    ++channels_cnt;
+    return 1;
+}
+
+/* Convert time to milliseconds, rounded up to the first millisecond that sees the change */
+static uint64_t
+prv_to_ms(double time_s) {
+    double ms = time_s * 1e3 - 1e-9;
+    uint64_t res;
+
+    if (ms <= 0) {
+        return 0;
+    }
+    res = (uint64_t)ms;
+    return (double)res < ms ? res + 1 : res;
+}
+
+/**
+ * \brief           Import value change dump
+ * \param[in]       file: Input file
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_import_vcd(FILE* file) {
+    char tok[256], id[256], name[256];
+    double timescale = 1e-9, time_s = 0;
+    size_t width;
+
+    while (fscanf(file, "%255s", tok) == 1) {
+        if (strcmp(tok, "$timescale") == 0) {
+            char unit[32] = "";
+            double num = 1;
+
+            /* Number and unit, separated or not */
+            if (fscanf(file, "%255s", tok) != 1) {
+                return 0;
+            }
+            if (sscanf(tok, "%lf%31s", &num, unit) < 2 && fscanf(file, "%31s", unit) != 1) {
+                return 0;
+            }
+            timescale = num;
+            switch (unit[0]) {
+                case 'm': timescale *= 1e-3; break;
+                case 'u': timescale *= 1e-6; break;
+                case 'n': timescale *= 1e-9; break;
+                case 'p': timescale *= 1e-12; break;
+                case 'f': timescale *= 1e-15; break;
+                default: break;
+            }
+        } else if (strcmp(tok, "$var") == 0) {
+            if (fscanf(file, "%255s %zu %255s %255s", tok, &width, id, name) != 4) {
+                return 0;
+            }
+            if (width == 1) {
+                if (!prv_channel_add(id)) {
+                    return 0;
+                }
+                printf("Button %u: %s\r\n", (unsigned)(channels_cnt - 1), name);
+            }
+        } else if (strcmp(tok, "$dumpvars") == 0 || strcmp(tok, "$dumpon") == 0 || strcmp(tok, "$dumpoff") == 0
+                   || strcmp(tok, "$end") == 0 || strcmp(tok, "$dumpall") == 0) {
+            /* Value changes follow */
+        } else if (tok[0] == '$') {
+            /* Skip other sections */
+            while (fscanf(file, "%255s", tok) == 1 && strcmp(tok, "$end") != 0) {}
+        } else if (tok[0] == '#') {
+            time_s = strtod(&tok[1], NULL) * timescale;
+        } else if (tok[0] == 'b' || tok[0] == 'B' || tok[0] == 'r' || tok[0] == 'R') {
+            /* Vector and real values, identifier follows */
+            if (fscanf(file, "%255s", tok) != 1) {
+                return 0;
+            }
+        } else if (tok[0] == '0' || tok[0] == '1') {
+            for (size_t i = 0; i < channels_cnt; ++i) {
+                if (strcmp(channels[i].id, &tok[1]) == 0) {
+                    prv_sample(i, prv_to_ms(time_s), (uint8_t)(tok[0] - '0'));
+                    break;
+                }
+            }
+        }
+        /* Unknown states x and z keep last value */
+    }
+    prv_finish(prv_to_ms(time_s));
+    return 1;
+}
+
+/**
+ * \brief           Import sigrok-style CSV
+ * \param[in]       file: Input file
+ * \param[in]       samplerate: Sample rate in Hz, `0` to take it from the file
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_import_csv(FILE* file, double samplerate) {
+    char line[4096];
+    uint64_t sample = 0, time_ms = 0;
+    size_t columns = 0;
+    int time_col = -1;
+    uint8_t header = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char* tok;
+        size_t col = 0;
+        double time_s = -1;
+
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == ';') {
+            char* rate = strstr(line, "Samplerate:");
+            char unit[16] = "";
+            double num;
+
+            if (samplerate <= 0 && rate != NULL && sscanf(rate + 11, "%lf %15s", &num, unit) >= 1) {
+                switch (unit[0]) {
+                    case 'k': num *= 1e3; break;
+                    case 'M': num *= 1e6; break;
+                    case 'G': num *= 1e9; break;
+                    default: break;
+                }
+                samplerate = num;
+            }
+            continue;
+        }
+        if (line[0] == '\0') {
+            continue;
+        }
+
+        /* Header with column names, or columns are numbered */
+        if (!header) {
+            header = 1;
+            if (!isdigit((unsigned char)line[0]) && line[0] != '-') {
+                for (tok = strtok(line, ","); tok != NULL; tok = strtok(NULL, ","), ++columns) {
+                    while (isspace((unsigned char)*tok)) {
+                        ++tok;
+                    }
+                    if (time_col < 0 && (tok[0] == 'T' || tok[0] == 't') && strncmp(&tok[1], "ime", 3) == 0) {
+                        time_col = (int)columns;
+                    } else if (!prv_channel_add(tok)) {
+                        return 0;
+                    } else {
+                        printf("Button %u: %s\r\n", (unsigned)(channels_cnt - 1), tok);
+                    }
+                }
+                if (time_col < 0 && samplerate <= 0) {
+                    printf("Sample rate is not known, use --samplerate\r\n");
+                    return 0;
+                }
+                continue;
+            }
+        }
+
+        for (tok = strtok(line, ","); tok != NULL; tok = strtok(NULL, ","), ++col) {
+            size_t ch = time_col >= 0 && col > (size_t)time_col ? col - 1 : col;
+
+            if ((int)col == time_col) {
+                time_s = strtod(tok, NULL);
+                continue;
+            }
+            /* Columns without header */
+            if (columns == 0 && ch >= channels_cnt) {
+                char id[16];
+
+                snprintf(id, sizeof(id), "D%u", (unsigned)ch);
+                if (samplerate <= 0 || !prv_channel_add(id)) {
+                    printf("Sample rate is not known, use --samplerate\r\n");
+                    return 0;
+                }
+            }
+            if (ch < channels_cnt) {
+                time_ms = time_s >= 0 ? prv_to_ms(time_s) : prv_to_ms((double)sample / samplerate);
+                prv_sample(ch, time_ms, (uint8_t)(strtol(tok, NULL, 0) != 0));
+            }
+        }
+        ++sample;
+    }
+    prv_finish(time_ms);
+    return 1;
+}
+
+/**
+ * \brief           Read whole file to memory
+ * \param[in]       path: File path
+ * \param[out]      len: Length of the file in bytes
+ * \return          File data, `NULL` on failure
+ */
+static uint8_t*
+prv_read_file(const char* path, size_t* len) {
+    FILE* file = fopen(path, "rb");
+    uint8_t* data = NULL;
+    long size;
+
+    if (file == NULL) {
+        return NULL;
+    }
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0
+        && (data = malloc((size_t)size + 1)) != NULL) {
+        *len = fread(data, 1, (size_t)size, file);
+    }
+    fclose(file);
+    return data;
+}
+
+/**
+ * \brief           Write trace to the file
+ * \param[in]       path: File path
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_write_file(const char* path) {
+    FILE* file = fopen(path, "wb");
+    uint8_t res;
+
+    if (file == NULL) {
+        return 0;
+    }
+    res = fwrite(trace.buff, 1, trace.len, file) == trace.len;
+    fclose(file);
+    return res;
+}
+
+/* Input states are taken from the replayed trace */
+static uint8_t
+prv_get_state(struct lwbtn* lwobj, struct lwbtn_btn* btn) {
+    (void)lwobj;
+    (void)btn;
+    return 0;
+}
+
+/* Events are printed from the recorded trace, after replay */
+static void
+prv_event(struct lwbtn* lwobj, struct lwbtn_btn* btn, lwbtn_evt_t evt) {
+    (void)lwobj;
+    (void)btn;
+    (void)evt;
+}
+
+/**
+ * \brief           Print records of the trace
+ * \param[in]       data: Trace data
+ * \param[in]       len: Length of trace data
+ * \param[in]       evts_only: Set to `1` to only print events
+ * \return          `1` on success, `0` when trace is not valid
+ */
+static uint8_t
+prv_print(const uint8_t* data, size_t len, uint8_t evts_only) {
+    lwbtn_trace_rec_t rec = {0};
+    size_t pos = 0;
+
+    printf(evts_only ? "time,button,event\n" : "time,type,button,value\n");
+    while (lwbtn_trace_read(data, len, &pos, &rec)) {
+        if (evts_only) {
+            if (rec.type == LWBTN_TRACE_REC_EVT) {
+                printf("%lu,%u,%s\n", (unsigned long)rec.time, (unsigned)rec.btn_idx,
+                       rec.val < sizeof(evt_names) / sizeof(evt_names[0]) ? evt_names[rec.val] : "unknown");
+            }
+        } else if (rec.type == LWBTN_TRACE_REC_MARK) {
+            printf("%lu,mark,,\n", (unsigned long)rec.time);
+        } else {
+            printf("%lu,%s,%u,%u\n", (unsigned long)rec.time, rec.type == LWBTN_TRACE_REC_INPUT ? "input" : "event",
+                   (unsigned)rec.btn_idx, (unsigned)rec.val);
+        }
+    }
+    return pos == len;
+}
+
+/**
+ * \brief           Replay trace, events are recorded to the output trace
+ * \param[in]       data: Trace data
+ * \param[in]       len: Length of trace data
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_replay(const uint8_t* data, size_t len) {
+    lwbtn_trace_rec_t rec = {0}, last = {0};
+    lwbtn_word_t *states, *replay_states;
+    lwbtn_btn_t* btns;
+    lwbtn_t lw;
+    size_t pos = 0, btns_cnt = 0, size = len * 2 + 4096;
+    uint8_t res = 0;
+
+    while (lwbtn_trace_read(data, len, &pos, &rec)) {
+        if (rec.type != LWBTN_TRACE_REC_MARK && rec.btn_idx >= btns_cnt) {
+            btns_cnt = (size_t)rec.btn_idx + 1;
+        }
+        last = rec;
+    }
+    btns = calloc(btns_cnt > 0 ? btns_cnt : 1, sizeof(*btns));
+    states = calloc(LWBTN_BITMAP_WORDS(btns_cnt) + 1, sizeof(*states));
+    replay_states = calloc(LWBTN_BITMAP_WORDS(btns_cnt) + 1, sizeof(*replay_states));
+    if (btns == NULL || states == NULL || replay_states == NULL) {
+        goto out;
+    }
+
+    /* Repeat with larger memory, when recording does not fit */
+    do {
+        free(trace.buff);
+        if ((trace.buff = malloc(size)) == NULL) {
+            goto out;
+        }
+        lwbtn_trace_init(&trace, trace.buff, size);
+        size *= 2;
+
+        memset(btns, 0x00, btns_cnt * sizeof(*btns));
+        lwbtn_init_ex(&lw, btns, (uint16_t)btns_cnt, prv_get_state, prv_event);
+        lwbtn_trace_attach(&lw, &trace, states);
+        res = lwbtn_trace_replay(&lw, data, len, replay_states);
+    } while (res && trace.overflow);
+    if (res && last.type == LWBTN_TRACE_REC_MARK) {
+        prv_write(&last);
+    }
+
+out:
+    free(replay_states);
+    free(states);
+    free(btns);
+    return res;
+}
+
+int
+main(int argc, char* argv[]) {
+    const char* record = NULL;
+    double samplerate = 0;
+    FILE* file;
+    uint8_t* data;
+    size_t len = 0;
+    uint8_t res;
+
+    if (argc < 3) {
+        printf("Usage: %s vcd|csv <in> <out.bin> [--active-low] [--samplerate HZ]\r\n", argv[0]);
+        printf("       %s dump <in.bin>\r\n", argv[0]);
+        printf("       %s replay <in.bin> [--record out.bin]\r\n", argv[0]);
+        return -1;
+    }
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--active-low") == 0) {
+            active_low = 1;
+        } else if (strcmp(argv[i], "--samplerate") == 0 && i + 1 < argc) {
+            samplerate = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record = argv[++i];
+        }
+    }
+
+    if (strcmp(argv[1], "vcd") == 0 || strcmp(argv[1], "csv") == 0) {
+        if (argc < 4 || (file = fopen(argv[2], "r")) == NULL) {
+            printf("Cannot open input file\r\n");
+            return -1;
+        }
+        res = argv[1][0] == 'v' ? prv_import_vcd(file) : prv_import_csv(file, samplerate);
+        fclose(file);
+        if (!res || !prv_write_file(argv[3])) {
+            printf("Import failed\r\n");
+            return -1;
+        }
+        printf("Imported %u buttons, %u ms, %u bytes\r\n", (unsigned)channels_cnt, (unsigned)trace.time,
+               (unsigned)trace.len);
+        return 0;
+    }
+
+    if ((data = prv_read_file(argv[2], &len)) == NULL) {
+        printf("Cannot open input file\r\n");
+        return -1;
+    }
+    if (strcmp(argv[1], "dump") == 0) {
+        res = prv_print(data, len, 0);
+    } else if (strcmp(argv[1], "replay") == 0) {
+        res = prv_replay(data, len) && prv_print(trace.buff, trace.len, 1)
+              && (record == NULL || prv_write_file(record));
+    } else {
+        printf("Unknown command %s\r\n", argv[1]);
+        res = 0;
+    }
+    free(data);
+    free(trace.buff);
+    return res ? 0 : -1;
+}